@@ -0,0 +1,10 @@
+from typing import Any
+
+def run_ddar(
+    points: list[tuple[str, float, float]],
+    assumptions: list[tuple[str, list[str]]],
+    goals: list[tuple[str, list[str]]],
+    options: list[str] = ...,
+    name: str = ...,
+    max_levels: int = ...,
+) -> dict[str, Any]: ...
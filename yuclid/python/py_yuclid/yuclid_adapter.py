@@ -94,13 +94,28 @@ else:
 
 YUCLID_PATH = _yuclid_path
 
+try:
+    # The extension module runs the solver in-process.
+    from py_yuclid import _yuclid
+except ImportError:
+    _yuclid = None
+
 # We need to keep this here to fail fast. There's no way to use this module
-# without having the binary installed.
-if not YUCLID_PATH.is_file():
+# without having either the extension module or the binary installed.
+if _yuclid is None and not YUCLID_PATH.is_file():
     raise YuclidError(
         f"yuclid binary not found at {YUCLID_PATH}. Check your yuclid installation."
     )
 
+YUCLID_OPTIONS = [
+    "--disable-ar-dist",
+    "--disable-ar-squared",
+    "--disable-eqn-statements",
+    "--disable-ar-sin",
+    "--log-level",
+    "warning",
+]
+
 
 class YuclidStatus(str, Enum):
     SOLVED = "solved"
@@ -156,7 +171,10 @@ class YuclidAdapter(DeductionProvider):
 
     def _precompute(self, problem: ProblemSetup) -> None:
         self._precomputation_input = _write_yuclid_setup(problem)
-        yuclid_output = self._run_yuclid()
+        if _yuclid is not None:
+            yuclid_output = self._run_yuclid_in_process(problem)
+        else:
+            yuclid_output = self._run_yuclid()
 
         for he_deduction in yuclid_output.all_deductions:
             deduction: CachedDeduction
@@ -183,6 +201,35 @@ class YuclidAdapter(DeductionProvider):
             if he_deduction in yuclid_output.deductions_for_goal:
                 self._precomputed_deductions_for_goal.append(deduction)
 
+    def _run_yuclid_in_process(self, problem: ProblemSetup) -> YuclidOutput:
+        assert _yuclid is not None
+        t0 = time.perf_counter()
+        points, assumptions, goals = _yuclid_problem_data(problem)
+        try:
+            result = _yuclid.run_ddar(
+                points,
+                assumptions,
+                goals,
+                options=YUCLID_OPTIONS,
+                name=self.problem_name,
+            )
+        except RuntimeError as e:
+            error_msg = (
+                f"yuclid execution failed: {e}.\n"
+                f"Setup:\n{self.precomputation_input_str}"
+            )
+            LOGGER.error(error_msg)
+            raise YuclidError(error_msg) from e
+        he_output = YuclidOutput.model_validate(result)
+
+        run_time = time.perf_counter() - t0
+        LOGGER.info(
+            f"Ran yuclid in-process in {run_time:.2f}s. "
+            f"Precomputed {len(he_output.all_deductions)} deductions,"
+            f" {len(he_output.deductions_for_goal)} for goal."
+        )
+        return he_output
+
     def _run_yuclid(self) -> YuclidOutput:
         t0 = time.perf_counter()
         with tempfile.TemporaryDirectory() as temp_dir:
@@ -192,13 +239,8 @@ class YuclidAdapter(DeductionProvider):
                 YUCLID_PATH.as_posix(),
                 "--mode",
                 "ddar",
-                "--disable-ar-dist",
-                "--disable-ar-squared",
-                "--disable-eqn-statements",
-                "--disable-ar-sin",
+                *YUCLID_OPTIONS,
                 "--use-json",
-                "--log-level",
-                "warning",
                 "--input-file",
                 str(input_file_path),
             ]
@@ -372,15 +414,34 @@ def _write_yuclid_setup(problem: ProblemSetup) -> list[str]:
     return setup_lines
 
 
+def _yuclid_problem_data(
+    problem: ProblemSetup,
+) -> tuple[
+    list[tuple[str, float, float]],
+    list[tuple[str, list[str]]],
+    list[tuple[str, list[str]]],
+]:
+    """Same as `_write_yuclid_setup`, as arguments of `_yuclid.run_ddar`."""
+    points = [(pt.name, float(pt.num.x), float(pt.num.y)) for pt in problem.points]
+    assumptions = [
+        (assumption.predicate_type.value, _predicate_args_to_yuclid(assumption))
+        for assumption in problem.assumptions
+        if assumption.predicate_type not in NUMERICAL_PREDICATES
+    ]
+    goals = [
+        (goal.predicate_type.value, _predicate_args_to_yuclid(goal))
+        for goal in problem.goals
+    ]
+    return points, assumptions, goals
+
+
+def _predicate_args_to_yuclid(predicate: PredicateConstruction) -> list[str]:
+    return [arg.replace("pi/", "/") for arg in predicate.args]
+
+
 def _predicate_to_yuclid(predicate: PredicateConstruction) -> str:
     predicate_name = predicate.predicate_type.value
-    args_txts: list[str] = []
-    for arg in predicate.args:
-        if "pi/" in arg:
-            args_txts.append(arg.replace("pi/", "/"))
-        else:
-            args_txts.append(arg)
-    return f"{predicate_name} {' '.join(args_txts)}"
+    return f"{predicate_name} {' '.join(_predicate_args_to_yuclid(predicate))}"
 
 
 YUCLID_RULES: set[Rule] = {
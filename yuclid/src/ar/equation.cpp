@@ -57,6 +57,20 @@ namespace Yuclid {
     return *this;
   }
 
+  // Fused multiply-add
+  template <typename VarT>
+  Equation<VarT>& Equation<VarT>::axpy(const Rat& coeff, const Equation& other) {
+    m_lhs.axpy(coeff, other.m_lhs);
+    if constexpr (requires { m_rhs.axpy(coeff, other.m_rhs); }) {
+      m_rhs.axpy(coeff, other.m_rhs);
+    } else {
+      RHSType rhs = other.m_rhs;
+      rhs *= coeff;
+      m_rhs += rhs;
+    }
+    return *this;
+  }
+
   // Compound multiplication
   template <typename VarT>
   Equation<VarT>& Equation<VarT>::operator*=(const Rat& multiplier) {
@@ -67,11 +81,16 @@ namespace Yuclid {
 
   // Unary minus
   template <typename VarT>
-  Equation<VarT> Equation<VarT>::operator-() const {
+  Equation<VarT> Equation<VarT>::operator-() const & {
     Equation result = *this; // Start with a copy
-    result.m_lhs = -result.m_lhs; // Negate LHS
-    result.m_rhs = -result.m_rhs;
-    return result;
+    return -std::move(result);
+  }
+
+  template <typename VarT>
+  Equation<VarT> Equation<VarT>::operator-() && {
+    m_lhs *= static_cast<Rat>(-1); // Negate LHS in place
+    m_rhs = -m_rhs;
+    return std::move(*this);
   }
 
   template<typename VarT>
@@ -93,28 +112,46 @@ namespace Yuclid {
 
   // Binary addition
   template <typename VarT>
-  Equation<VarT> Equation<VarT>::operator+(const Equation<VarT>& other) const {
+  Equation<VarT> Equation<VarT>::operator+(const Equation<VarT>& other) const & {
     Equation<VarT> result = *this; // Start with a copy of lhs_eq
     result += other; // Use compound assignment
     return result;
   }
 
+  template <typename VarT>
+  Equation<VarT> Equation<VarT>::operator+(const Equation<VarT>& other) && {
+    *this += other; // Reuse the storage of a temporary
+    return std::move(*this);
+  }
+
   // Binary subtraction
   template <typename VarT>
-  Equation<VarT> Equation<VarT>::operator-(const Equation<VarT>& other) const {
+  Equation<VarT> Equation<VarT>::operator-(const Equation<VarT>& other) const & {
     Equation<VarT> result = *this;
     result -= other; // Use compound assignment
     return result;
   }
 
+  template <typename VarT>
+  Equation<VarT> Equation<VarT>::operator-(const Equation<VarT>& other) && {
+    *this -= other;
+    return std::move(*this);
+  }
+
   // Binary multiplication (equation * coefficient)
   template <typename VarT>
-  Equation<VarT> Equation<VarT>::operator*(const Rat& multiplier) const {
+  Equation<VarT> Equation<VarT>::operator*(const Rat& multiplier) const & {
     Equation<VarT> result = *this; // Start with a copy
     result *= multiplier; // Use compound assignment
     return result;
   }
 
+  template <typename VarT>
+  Equation<VarT> Equation<VarT>::operator*(const Rat& multiplier) && {
+    *this *= multiplier;
+    return std::move(*this);
+  }
+
   // Binary multiplication (coefficient * equation)
   template <typename VarT>
   Equation<VarT> operator*(const Rat& multiplier, const Equation<VarT>& eq) {
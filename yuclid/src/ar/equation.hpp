@@ -76,7 +76,8 @@ namespace Yuclid {
      * @return A reference to this equation after addition.
      */
     Equation& operator+=(const Equation& other);
-    Equation operator+(const Equation& other) const;
+    Equation operator+(const Equation& other) const &;
+    Equation operator+(const Equation& other) &&;
 
     /**
      * @brief Compound subtraction operator. Subtracts another equation from this one.
@@ -85,7 +86,18 @@ namespace Yuclid {
      * @return A reference to this equation after subtraction.
      */
     Equation& operator-=(const Equation& other);
-    Equation operator-(const Equation& other) const;
+    Equation operator-(const Equation& other) const &;
+    Equation operator-(const Equation& other) &&;
+
+    /**
+     * @brief Adds `coeff * other` to this equation in place.
+     *
+     * Unlike `*this += coeff * other`, doesn't copy `other`.
+     * @param coeff The coefficient of `other`.
+     * @param other The equation to add; must not be `*this`.
+     * @return A reference to this equation after addition.
+     */
+    Equation& axpy(const Rat& coeff, const Equation& other);
 
     /**
      * @brief Compound multiplication operator. Multiplies both sides by a coefficient.
@@ -93,13 +105,15 @@ namespace Yuclid {
      * @return A reference to this equation after multiplication.
      */
     Equation& operator*=(const Rat& multiplier);
-    Equation operator*(const Rat& multiplier) const;
+    Equation operator*(const Rat& multiplier) const &;
+    Equation operator*(const Rat& multiplier) &&;
 
     /**
      * @brief Unary minus operator. Negates both sides of the equation.
      * @return A new equation with negated LHS and RHS.
      */
-    Equation operator-() const;
+    Equation operator-() const &;
+    Equation operator-() &&;
 
     /**
      * @brief Defaulted three-way comparison operator.
@@ -17,8 +17,8 @@
 #include <ostream>
 #include <cmath>     // For std::fabs (used by output operator)
 #include <functional> // For std::plus, std::minus
-#include <ranges>    // For std::ranges, std::views
-#include <vector>
+#include <cassert>
+#include <utility>   // For std::move
 #include "linear_combination.hpp"
 #include "ar/equation_traits.hpp"
 #include "ar/equation.hpp" // NOLINT
@@ -99,10 +99,66 @@ namespace Yuclid {
     return merged_result;
   }
 
+  template <typename VarT>
+  template <typename operation>
+  void LinearCombination<VarT>::merge_in_place(const LinearCombination<VarT>& other, operation op) {
+    assert(&other != this);
+    if (other.empty()) {
+      return;
+    }
+    size_t const old_size = m_terms.size();
+    // The new slots are placeholders, they are overwritten by the merge.
+    m_terms.resize(old_size + other.m_terms.size(), other.m_terms.front());
+
+    auto out = m_terms.end();
+    auto left = m_terms.begin() + static_cast<ptrdiff_t>(old_size);
+    auto right = other.m_terms.end();
+    bool has_zeros = false;
+    while (right != other.m_terms.begin()) {
+      if (left != m_terms.begin() && (right - 1)->first < (left - 1)->first) {
+        --left;
+        --out;
+        *out = std::move(*left);
+      } else if (left != m_terms.begin() && (left - 1)->first == (right - 1)->first) {
+        --left;
+        --right;
+        --out;
+        Rat combined_coeff = left->second + op(right->second);
+        has_zeros = has_zeros || combined_coeff == static_cast<Rat>(0);
+        out->first = std::move(left->first);
+        out->second = std::move(combined_coeff);
+      } else {
+        --right;
+        --out;
+        out->first = right->first;
+        out->second = op(right->second);
+      }
+    }
+    if (out == left && !has_zeros) {
+      // No common variables, all terms are in place.
+      return;
+    }
+    // Common variables leave a gap between the untouched prefix and the merged suffix.
+    auto first = std::move_backward(m_terms.begin(), left, out);
+    auto dest = m_terms.begin();
+    for (; first != m_terms.end(); ++first) {
+      if (first->second != static_cast<Rat>(0)) {
+        if (dest != first) {
+          *dest = std::move(*first);
+        }
+        ++dest;
+      }
+    }
+    m_terms.erase(dest, m_terms.end());
+  }
+
   // Compound addition
   template <typename VarT>
   LinearCombination<VarT>& LinearCombination<VarT>::operator+=(const LinearCombination<VarT>& other) {
-    *this = *this + other; // Reroute to binary operator+
+    if (&other == this) {
+      return *this *= static_cast<Rat>(2);
+    }
+    merge_in_place(other, std::identity{});
     return *this;
   }
 
@@ -115,7 +171,28 @@ namespace Yuclid {
   // Compound subtraction
   template <typename VarT>
   LinearCombination<VarT>& LinearCombination<VarT>::operator-=(const LinearCombination<VarT>& other) {
-    *this = *this - other; // Reroute to binary operator-
+    if (&other == this) {
+      m_terms.clear();
+      return *this;
+    }
+    merge_in_place(other, std::negate());
+    return *this;
+  }
+
+  // Fused multiply-add
+  template <typename VarT>
+  LinearCombination<VarT>& LinearCombination<VarT>::axpy(const Rat& coeff, const LinearCombination<VarT>& other) {
+    assert(&other != this);
+    if (coeff == static_cast<Rat>(0)) {
+      return *this;
+    }
+    if (coeff == static_cast<Rat>(1)) {
+      merge_in_place(other, std::identity{});
+    } else if (coeff == static_cast<Rat>(-1)) {
+      merge_in_place(other, std::negate());
+    } else {
+      merge_in_place(other, [&coeff](const Rat& val) { return coeff * val; });
+    }
     return *this;
   }
 
@@ -188,13 +265,8 @@ namespace Yuclid {
     if (multiplier == Rat(0)) {
       return LinearCombination<VarT>();
     }
-    LinearCombination<VarT> result;
-    result.m_terms =
-      m_terms
-      | views::transform([&multiplier](const auto& term) {
-        return make_pair(term.first, term.second * multiplier);
-      })
-      | ranges::to<vector>();
+    LinearCombination<VarT> result = *this;
+    result *= multiplier;
     return result;
   }
 
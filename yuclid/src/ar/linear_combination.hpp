@@ -24,9 +24,11 @@
 #include "type/slope_angle.hpp"
 #include "type/variable_types.hpp"
 
-#include <vector>              // For std::vector
+#include <algorithm>           // For std::lexicographical_compare_three_way
+#include <cstddef>             // For size_t
 #include <utility>             // For std::pair
 #include <ostream>             // For std::ostream
+#include <boost/container/small_vector.hpp>
 #include <boost/preprocessor.hpp>
 
 namespace Yuclid {
@@ -41,7 +43,9 @@ namespace Yuclid {
    * Coefficients of zero are not stored; terms are automatically
    * removed if their coefficient becomes zero after an operation.
    *
-   * Storage is managed using a std::vector of pairs, sorted by the variable.
+   * Storage is managed using a vector of pairs, sorted by the variable.
+   * Most equations of the AR tables have at most `inline_capacity` terms,
+   * so these are stored inline, without allocating memory.
    *
    * @tparam VarT The type of the geometric variable (e.g., `dist`, `SinOrDist`).
    */
@@ -50,7 +54,8 @@ namespace Yuclid {
   public:
     using VariableType = VarT;                                   /**< Alias for the variable type. */
     using EvaluationType = typename EquationTraits<VarT>::EvaluationType;   /**< Alias for the evaluation result type. */
-    using TermsVectorType = std::vector<std::pair<VariableType, Rat>>; /**< Alias for the internal vector type. */
+    static constexpr size_t inline_capacity = 6;                /**< Number of terms stored without allocation. */
+    using TermsVectorType = boost::container::small_vector<std::pair<VariableType, Rat>, inline_capacity>; /**< Alias for the internal vector type. */
 
   private:
     // The internal storage mapping variables to their coefficients.
@@ -65,6 +70,15 @@ namespace Yuclid {
                                           right_operation op_right,
                                           binary_operation binop) const;
 
+    /**
+     * @brief Add `op(c) * v` to `*this` for each term `c * v` of `other`, in place.
+     *
+     * Grows the storage once, then merges both sorted sequences from the back,
+     * so that each term is written to a slot that was already read.
+     */
+    template <typename operation>
+    void merge_in_place(const LinearCombination<VarT>& other, operation op);
+
   public:
     /**
      * @brief Default constructor. Creates an empty linear combination.
@@ -110,6 +124,16 @@ namespace Yuclid {
     LinearCombination& operator-=(const LinearCombination& other);
     LinearCombination operator-(const LinearCombination& rhs) const;
 
+    /**
+     * @brief Adds `coeff * other` to this linear combination in place.
+     *
+     * Unlike `*this += coeff * other`, doesn't build any temporary linear combinations.
+     * @param coeff The coefficient of `other`.
+     * @param other The linear combination to add; must not be `*this`.
+     * @return A reference to this linear combination after addition.
+     */
+    LinearCombination& axpy(const Rat& coeff, const LinearCombination& other);
+
     /**
      * @brief Multiplies this linear combination by a coefficient (compound assignment).
      * If the multiplier is zero, the combination becomes empty.
@@ -162,7 +186,14 @@ namespace Yuclid {
                                              const Rat& coeff_other,
                                              const LinearCombination<VarT>& other);
 
-    auto operator<=>(const LinearCombination& other) const = default;
+    auto operator<=>(const LinearCombination& other) const {
+      return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end(),
+                                                    [](const auto& lhs, const auto& rhs) { return lhs <=> rhs; });
+    }
+
+    bool operator==(const LinearCombination& other) const {
+      return m_terms == other.m_terms;
+    }
   };
 
   /**
@@ -25,8 +25,12 @@
 #include <string>    // For std::to_string, string concatenation
 #include <set>       // For std::set operations
 #include <map>       // For std::map operations
+#include <algorithm>
+#include <optional>
+#include <ranges>
 #include "ar/linear_system.hpp"
 #include "ar/linear_combination.hpp"
+#include "numbers/util.hpp"
 #include "solver/statement_proof.hpp"
 #include "statement/ratio_squared_dist.hpp"
 #include "type/dist.hpp"
@@ -37,37 +41,114 @@
 #include "typedef.hpp"
 
 #include <utility>
+#include <vector>
 
 using namespace std; // As per instruction, using namespace std at the top
 
 namespace Yuclid {
 
   template <typename VarT>
-  void LinearSystem<VarT>::reduce_next(LinearCombinationType &e) {
+  typename LinearSystem<VarT>::VariableId LinearSystem<VarT>::intern(const VarT &var) {
+    VariableId const id = m_variables.intern(var);
+    if (id == m_states.size()) {
+      m_states.emplace_back();
+    }
+    return id;
+  }
+
+  template <typename VarT>
+  bool LinearSystem<VarT>::may_eliminate(const LinearCombinationType &e, const LinearCombinationType &row) const {
+    const auto &terms = e.rhs().lhs().terms();
+    // The pivot of `row` cancels the second term of `e`,
+    // the other terms of `row` are larger than it.
+    const auto row_terms = row.rhs().lhs().terms() | views::drop(1);
+    const auto term_less = [](const auto &term, const VarT &var) { return term.first < var; };
+    switch (m_throttle) {
+    case Config::EliminationThrottle::NONE:
+      return true;
+    case Config::EliminationThrottle::LEAST_FILL: {
+      // `e` doesn't get longer if `row` brings at most one new variable.
+      size_t fill = 0;
+      auto it = std::next(terms.begin(), 2);
+      for (const auto &[var, coeff] : row_terms) {
+        it = lower_bound(it, terms.end(), var, term_less);
+        if ((it == terms.end() || var < it->first) && ++ fill > 1) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Config::EliminationThrottle::MIN_HEIGHT: {
+      size_t max_height = 0;
+      for (const auto &[var, coeff] : terms) {
+        max_height = max(max_height, rat_height(coeff));
+      }
+      // Only the coefficients of the variables of `row` change.
+      Rat const c = terms[1].second;
+      auto it = std::next(terms.begin(), 2);
+      for (const auto &[var, coeff] : row_terms) {
+        it = lower_bound(it, terms.end(), var, term_less);
+        Rat const val = it == terms.end() || var < it->first ? -(c * coeff) : it->second - c * coeff;
+        if (rat_height(val) > max_height) {
+          return false;
+        }
+      }
+      return true;
+    }
+    }
+    return true;
+  }
+
+  template <typename VarT>
+  bool LinearSystem<VarT>::reduce_next(LinearCombinationType &e) {
+    VariableId const head = m_variables.find(e.rhs().lhs().begin()->first);
+    bool changed = false;
     while (true) {
-      const auto &it_begin = e.rhs().lhs().begin();
       // An iterator pointing at the 2nd term in the LHS of the equation.
-      const auto &it_next = std::next(it_begin);
-
-      VarT head_var = it_begin->first;
+      const auto &it_next = std::next(e.rhs().lhs().begin());
 
       if (it_next == e.rhs().lhs().end()) {
         // Only the pivot term left.
-        m_found_variables.insert(head_var);
+        insert_found(head);
         break;
       }
 
       auto [next_var, next_coeff] = *it_next;
 
-      const auto &echelon_it = m_echelon_form.find(next_var);
+      VariableState &next = state(next_var);
       // No more reductions to the next term.
       // Register in the cache and return.
-      if (echelon_it == m_echelon_form.end()) {
-        m_pivot_by_next[next_var].insert(head_var);
+      if (next.row == no_row) {
+        next.pivots_by_next.push_back(head);
         break;
       }
 
-      e -= next_coeff * echelon_it->second;
+      const LinearCombinationType &row = m_echelon_form[next.row];
+      if (!may_eliminate(e, row)) {
+        // Try again when `row` changes, see `reduce_postponed()`.
+        ++ m_num_postponed;
+        next.postponed_by_next.push_back(head);
+        break;
+      }
+      e.axpy(-next_coeff, row);
+      changed = true;
+    }
+    return changed;
+  }
+
+  template <typename VarT>
+  void LinearSystem<VarT>::reduce_postponed(vector<VariableId> changed) {
+    while (!changed.empty()) {
+      VariableId const id = changed.back();
+      changed.pop_back();
+      vector<VariableId> const postponed = std::move(m_states[id].postponed_by_next);
+      m_states[id].postponed_by_next.clear();
+      for (VariableId const other : postponed) {
+        if (reduce_next(m_echelon_form[m_states[other].row])) {
+          update_mod_row(m_states[other].row);
+          changed.push_back(other);
+        }
+      }
     }
   }
 
@@ -99,25 +180,294 @@ namespace Yuclid {
     assert(lc.rhs() == eq->remainder());
     assert(!lc.rhs().lhs().empty());
 
+    for (const auto &term : lc.rhs().lhs()) {
+      intern(term.first);
+    }
+
     auto [v, c] = *(lc.rhs().lhs().begin());
-    assert(!m_echelon_form.contains(v));
+    assert(pivot_row(v) == nullptr);
+    assert(link_to_representative(v) == nullptr);
+
+    // Fast path for `x - y = c`
+    const auto &terms = lc.rhs().lhs().terms();
+    if (m_union_find && terms.size() == 2 && (c == 1 || c == -1) && terms[1].second == -c &&
+        try_merge_classes(c == 1 ? lc : -lc)) {
+      return;
+    }
+
     lc *= Rat(1) / c;
+    for (const auto &term : lc.rhs().lhs()) {
+      state(term.first).in_rows = true;
+    }
     reduce_next(lc);
-    if (!m_echelon_form.insert(make_pair(v, lc)).second) {
+    VariableId const pivot = m_variables.find(v);
+    if (m_states[pivot].row != no_row) {
       throw std::runtime_error("Trying to inssert a non-reduced equation");
     }
+    m_states[pivot].row = static_cast<uint32_t>(m_echelon_form.size());
+    m_states[pivot].pivoted_at = ++ m_version;
+    m_echelon_form.push_back(std::move(lc));
+    update_mod_row(m_states[pivot].row);
 
     // Partial back substitution
-    auto it = m_pivot_by_next.find(v);
-    if (it != m_pivot_by_next.end()) {
-      for (const auto &pivot : it->second) {
-        auto it_pivot = m_echelon_form.find(pivot);
-        assert(it_pivot != m_echelon_form.end());
-        reduce_next(it_pivot->second);
+    vector<VariableId> const rows_to_reduce = std::move(m_states[pivot].pivots_by_next);
+    m_states[pivot].pivots_by_next.clear();
+    vector<VariableId> changed;
+    for (VariableId const other : rows_to_reduce) {
+      assert(m_states[other].row != no_row);
+      if (reduce_next(m_echelon_form[m_states[other].row])) {
+        update_mod_row(m_states[other].row);
+        changed.push_back(other);
       }
-      m_pivot_by_next.erase(it);
     }
+    reduce_postponed(std::move(changed));
+
+    // Equations with leading variable `v` can be reduced further now.
+    wake_watchers(pivot);
+  }
+
+  template <typename VarT>
+  bool LinearSystem<VarT>::try_merge_classes(LinearCombinationType lc) {
+    VariableId const left = m_variables.find(lc.rhs().lhs().terms()[0].first);
+    VariableId const right = m_variables.find(lc.rhs().lhs().terms()[1].first);
+    assert(m_states[left].link == no_row && m_states[right].link == no_row);
+    bool const left_in_rows = m_states[left].in_rows;
+    bool const right_in_rows = m_states[right].in_rows;
+    if (left_in_rows && right_in_rows) {
+      return false;
+    }
+    // Keep the representative that occurs in the echelon form,
+    // otherwise merge the smaller class into the larger one.
+    bool const flip = !right_in_rows &&
+      (left_in_rows || m_states[left].members.size() > m_states[right].members.size());
+    if (flip) {
+      // Now `lc.rhs()` is `left - right = c`, we need `right - left = -c`.
+      lc = -std::move(lc);
+    }
+    VariableId const child = flip ? right : left;
+    VariableId const root = flip ? left : right;
+
+    vector<VariableId> child_members = std::move(m_states[child].members);
+    m_states[child].members.clear();
+    for (VariableId const var : child_members) {
+      // `var - child = a` plus `child - root = b`
+      m_links[m_states[var].link] += lc;
+    }
+    m_states[child].link = static_cast<uint32_t>(m_links.size());
+    m_links.push_back(std::move(lc));
+    child_members.push_back(child);
+    ++ m_version;
+    m_states[root].linked_at = m_version;
+    for (VariableId const var : child_members) {
+      m_states[var].linked_at = m_version;
+    }
+
+    // Members of a found class are found too.
+    VariableState &root_state = m_states[root];
+    bool const found = root_state.row != no_row &&
+      m_echelon_form[root_state.row].rhs().lhs().terms().size() == 1;
+    for (VariableId const var : child_members) {
+      if (found) {
+        mark_found(var);
+      }
+      root_state.members.push_back(var);
+    }
+
+    // Remainders may contain any member of the child class,
+    // and reducing them modulo the new link can now make progress.
+    for (VariableId const var : child_members) {
+      wake_watchers(var);
+    }
+    wake_watchers(root);
+    return true;
+  }
 
+  template <typename VarT>
+  void LinearSystem<VarT>::update_mod_row(uint32_t row) {
+    if (!m_mod_rows_valid) [[unlikely]] {
+      return;
+    }
+    vector<pair<VariableId, ModPrime>> image;
+    image.reserve(m_echelon_form[row].rhs().lhs().terms().size());
+    for (const auto &[var, coeff] : m_echelon_form[row].rhs().lhs()) {
+      optional<ModPrime> const c = ModPrime::of_rat(coeff);
+      if (!c.has_value()) [[unlikely]] {
+        m_mod_rows_valid = false;
+        m_mod_rows = {};
+        return;
+      }
+      if (*c != ModPrime()) {
+        image.emplace_back(m_variables.find(var), *c);
+      }
+    }
+    if (row == m_mod_rows.size()) {
+      m_mod_rows.push_back(std::move(image));
+    } else {
+      m_mod_rows[row] = std::move(image);
+    }
+  }
+
+  template <typename VarT>
+  optional<VarT> LinearSystem<VarT>::modular_leading_variable(const LinearCombination<VarT> &lhs) const {
+    ++ m_num_modular_checks;
+    if (!m_mod_rows_valid) [[unlikely]] {
+      return nullopt;
+    }
+    // Terms by variable id, sorted in the order of the variables.
+    using Terms = vector<pair<VariableId, ModPrime>>;
+    const auto var_less = [this](VariableId left, VariableId right) {
+      return m_variables.var(left) < m_variables.var(right);
+    };
+    // The image of `lhs` with each variable replaced by its representative.
+    // Variables that never occurred in the system can't be cancelled,
+    // so only the first of them matters.
+    Terms rem;
+    rem.reserve(lhs.terms().size());
+    optional<VarT> fresh;
+    for (const auto &[var, coeff] : lhs) {
+      optional<ModPrime> const c = ModPrime::of_rat(coeff);
+      if (!c.has_value()) [[unlikely]] {
+        return nullopt;
+      }
+      VariableId id = m_variables.find(var);
+      if (id == VariableInterner<VarT>::no_id) {
+        if (*c != ModPrime() && !fresh.has_value()) {
+          fresh = var;
+        }
+        continue;
+      }
+      if (m_states[id].link != no_row) {
+        // `c * var` minus `c * (var - root)`
+        const auto &terms = m_links[m_states[id].link].rhs().lhs().terms();
+        id = m_variables.find(terms[0].first == var ? terms[1].first : terms[0].first);
+      }
+      rem.emplace_back(id, *c);
+    }
+    ranges::sort(rem, var_less, &pair<VariableId, ModPrime>::first);
+    Terms next;
+    next.reserve(rem.size());
+    for (auto &term : rem) {
+      if (!next.empty() && next.back().first == term.first) {
+        next.back().second += term.second;
+      } else {
+        next.push_back(term);
+      }
+    }
+    erase_if(next, [](const auto &term) { return term.second == ModPrime(); });
+    std::swap(rem, next);
+
+    while (!rem.empty() && !(fresh.has_value() && *fresh < m_variables.var(rem.front().first))) {
+      const VariableState &st = m_states[rem.front().first];
+      if (st.row == no_row) {
+        ++ m_num_modular_rejections;
+        return m_variables.var(rem.front().first);
+      }
+      // `rem -= c * row`; the pivot has coefficient 1, so the leading term cancels.
+      const Terms &row = m_mod_rows[st.row];
+      ModPrime const c = rem.front().second;
+      next.clear();
+      auto it1 = rem.begin();
+      auto it2 = row.begin();
+      while (it1 != rem.end() || it2 != row.end()) {
+        if (it2 == row.end() || (it1 != rem.end() && var_less(it1->first, it2->first))) {
+          next.push_back(*it1);
+          ++ it1;
+        } else if (it1 == rem.end() || var_less(it2->first, it1->first)) {
+          next.emplace_back(it2->first, -(c * it2->second));
+          ++ it2;
+        } else {
+          ModPrime const val = it1->second - (c * it2->second);
+          if (val != ModPrime()) {
+            next.emplace_back(it1->first, val);
+          }
+          ++ it1;
+          ++ it2;
+        }
+      }
+      std::swap(rem, next);
+    }
+    if (fresh.has_value()) {
+      ++ m_num_modular_rejections;
+    }
+    return fresh;
+  }
+
+  template <typename VarT>
+  typename LinearSystem<VarT>::EchelonStats LinearSystem<VarT>::echelon_stats() const {
+    EchelonStats stats;
+    stats.num_rows = m_echelon_form.size();
+    for (const auto &row : m_echelon_form) {
+      for (const auto &[var, coeff] : row.rhs().lhs()) {
+        size_t const height = rat_height(coeff);
+        ++ stats.num_terms;
+        stats.max_height = max(stats.max_height, height);
+        stats.total_height += height;
+      }
+    }
+    return stats;
+  }
+
+  template <typename VarT>
+  void LinearSystem<VarT>::mark_found(VariableId id) {
+    if (!m_states[id].found) {
+      m_states[id].found = true;
+      m_found_variables.push_back(id);
+    }
+  }
+
+  template <typename VarT>
+  void LinearSystem<VarT>::insert_found(VariableId id) {
+    mark_found(id);
+    for (VariableId const member : m_states[id].members) {
+      mark_found(member);
+    }
+  }
+
+  template <typename VarT>
+  void LinearSystem<VarT>::wake_watchers(VariableId id) {
+    if (m_states[id].watchers.empty()) {
+      return;
+    }
+    // Notified statements may add equations, hence watchers, to this system.
+    auto watchers = std::move(m_states[id].watchers);
+    m_states[id].watchers.clear();
+    for (auto *watcher : watchers) {
+      watcher->notify_watchers();
+    }
+  }
+
+  template <typename VarT>
+  const typename LinearSystem<VarT>::LinearCombinationType *
+  LinearSystem<VarT>::link_to_representative(const VarT &var) const {
+    const VariableState *st = find_state(var);
+    return st == nullptr || st->link == no_row ? nullptr : &m_links[st->link];
+  }
+
+  template <typename VarT>
+  typename LinearSystem<VarT>::RHSType LinearSystem<VarT>::found_value(const VarT &var) const {
+    const LinearCombinationType *link_lc = link_to_representative(var);
+    if (link_lc == nullptr) {
+      return pivot_row(var)->rhs().rhs();
+    }
+    const auto &link = link_lc->rhs();
+    const VarT &root = link.lhs().terms()[0].first == var ?
+      link.lhs().terms()[1].first : link.lhs().terms()[0].first;
+    // `var - root = offset` plus `root = value`
+    return (link + pivot_row(root)->rhs()).rhs();
+  }
+
+  template <typename VarT>
+  void LinearSystem<VarT>::watch(const VariableType &var, StatementProof *pf) {
+    auto &watchers = m_states[intern(var)].watchers;
+    if (ranges::find(watchers, pf) == watchers.end()) {
+      watchers.push_back(pf);
+    }
+  }
+
+  template <typename VarT>
+  bool LinearSystem<VarT>::is_watched_by(const VariableType &var, const StatementProof *pf) const {
+    const VariableState *st = find_state(var);
+    return st != nullptr && ranges::find(st->watchers, pf) != st->watchers.end();
   }
 
   template <typename VarT>
@@ -140,11 +490,76 @@ namespace Yuclid {
     if constexpr (std::is_same_v<VarT, SlopeAngle>) {
       return {};
     } else {
+      // The first two terms of an equation `pivot + coeff * next + ... = rhs`.
+      struct Row {
+        Rat coeff;
+        bool two_terms;
+        RHSType rhs;
+      };
+      // Rows of the echelon form sharing the same next variable, by pivot.
+      // Members of union-find classes act as pivots of rows
+      // `var + coeff * next + ... = rhs + offset` or `var - root = offset`,
+      // as if the two-term equations were added to the echelon form.
+      map<VarT, map<VarT, Row>> buckets;
+      const auto link_offset = [this](VariableId id) -> const RHSType & {
+        return m_links[m_states[id].link].rhs().rhs();
+      };
+      for (VariableId next = 0; next < m_states.size(); ++next) {
+        const auto &pivots_sharing_next = m_states[next].pivots_by_next;
+        if (pivots_sharing_next.empty()) {
+          continue;
+        }
+        auto &bucket = buckets[m_variables.var(next)];
+        for (VariableId const pivot : pivots_sharing_next) {
+          const auto &eqn = m_echelon_form[m_states[pivot].row].rhs();
+          Row const row{std::next(eqn.lhs().begin())->second, eqn.lhs().terms().size() == 2, eqn.rhs()};
+          bucket.emplace(m_variables.var(pivot), row);
+          for (VariableId const var : m_states[pivot].members) {
+            bucket.emplace(m_variables.var(var), Row{row.coeff, row.two_terms, row.rhs + link_offset(var)});
+          }
+        }
+      }
+      for (VariableId root_id = 0; root_id < m_states.size(); ++root_id) {
+        const VariableState &root_state = m_states[root_id];
+        if (root_state.row != no_row || root_state.members.empty()) {
+          continue;
+        }
+        // In the echelon form, the members of a class would be expressed
+        // in terms of its largest member, so this is the next variable.
+        const VarT &root = m_variables.var(root_id);
+        VariableId terminal_id = root_id;
+        for (VariableId const var : root_state.members) {
+          if (m_variables.var(terminal_id) < m_variables.var(var)) {
+            terminal_id = var;
+          }
+        }
+        const VarT &terminal = m_variables.var(terminal_id);
+        RHSType const terminal_offset =
+          terminal_id == root_id ? RHSType() : link_offset(terminal_id);
+        auto &bucket = buckets[terminal];
+        if (terminal_id != root_id) {
+          // `pivot + coeff * root = rhs` becomes `pivot + coeff * terminal = rhs + coeff * terminal_offset`
+          auto root_it = buckets.find(root);
+          if (root_it != buckets.end()) {
+            for (const auto &[pivot, row] : root_it->second) {
+              bucket.emplace(pivot, Row{row.coeff, row.two_terms, row.rhs + row.coeff * terminal_offset});
+            }
+            buckets.erase(root_it);
+          }
+          bucket.emplace(root, Row{Rat(-1), true, -terminal_offset});
+        }
+        for (VariableId const var : root_state.members) {
+          if (var != terminal_id) {
+            bucket.emplace(m_variables.var(var), Row{Rat(-1), true, link_offset(var) - terminal_offset});
+          }
+        }
+      }
+
       vector<RatioSquaredDist> res;
-      for (const auto& [next_var, pivots_sharing_next] : m_pivot_by_next) {
+      for (const auto& [next_var, pivots_sharing_next] : buckets) {
         // Iterate over pairs of distinct pivots (i, j) within this bucket where i < j
         for (auto it_i = pivots_sharing_next.begin(); it_i != pivots_sharing_next.end(); ++it_i) {
-          const VarT& i_var = *it_i;
+          const VarT& i_var = it_i->first;
 
           // We get no `ratio_squared_dist`s from something like `\sin α = \sin b` or `\sin α = 3|bc|`.
           if constexpr (std::is_same_v<VarT, SinOrDist>) {
@@ -153,24 +568,21 @@ namespace Yuclid {
             }
           }
 
-          // Get the echelon form equation for pivot 'i_var'
-          const auto& eq_i_lc = m_echelon_form.at(i_var);
-          // Get the coefficient of the 'next_var' in eq_i_lc.rhs().lhs()
-          // (i.e., the coefficient 'a' for 'next_var' in the equation where 'i_var' is pivot)
-          auto eq_i_coeff = std::next(eq_i_lc.rhs().lhs().begin())->second;
+          // The coefficient 'a' for 'next_var' in the equation where 'i_var' is pivot
+          const Rat &eq_i_coeff = it_i->second.coeff;
 
           // If the LHS has only 2 terms, then we can find `i_var`
           // in terms of `next_var`
-          if (eq_i_lc.rhs().lhs().terms().size() == 2) {
+          if (it_i->second.two_terms) {
             if constexpr (is_same_v<VarT, Dist>) {
-              if (eq_i_lc.rhs().rhs() == RHSType()) {
+              if (it_i->second.rhs == RHSType()) {
                 assert(eq_i_coeff < 0);
                 res.emplace_back(SquaredDist(i_var), SquaredDist(next_var),
                                  rat2nnrat(eq_i_coeff * eq_i_coeff));
               }
             } else if constexpr (is_same_v<VarT, SquaredDist>) {
               assert(eq_i_coeff < 0);
-              if (eq_i_lc.rhs().rhs() == RHSType()) {
+              if (it_i->second.rhs == RHSType()) {
                 res.emplace_back(SquaredDist(i_var), SquaredDist(next_var),
                                  rat2nnrat(-eq_i_coeff));
               }
@@ -185,11 +597,11 @@ namespace Yuclid {
           }
 
           for (auto it_j = std::next(it_i); it_j != pivots_sharing_next.end(); ++it_j) {
-            const auto& eq_j_lc = m_echelon_form.at(*it_j);
-            auto eq_j_coeff = std::next(eq_j_lc.rhs().lhs().begin())->second;
+            const VarT &j_var = it_j->first;
+            const Rat &eq_j_coeff = it_j->second.coeff;
 
             if constexpr (std::is_same_v<VarT, Dist>) {
-              res.emplace_back(SquaredDist(i_var), SquaredDist(*it_j),
+              res.emplace_back(SquaredDist(i_var), SquaredDist(j_var),
                                rat2nnrat((eq_i_coeff * eq_i_coeff) /
                                          (eq_j_coeff * eq_j_coeff)));
             } else if constexpr (std::is_same_v<VarT, SquaredDist>) {
@@ -197,14 +609,14 @@ namespace Yuclid {
               if (c < 0) {
                 continue;
               }
-              res.emplace_back(i_var, *it_j, rat2nnrat(eq_i_coeff / eq_j_coeff));
+              res.emplace_back(i_var, j_var, rat2nnrat(eq_i_coeff / eq_j_coeff));
             } else {
               static_assert(std::is_same_v<VarT, SinOrDist>,
                             "We should deal with the ratios table in this branch.");
-              // Since the set is sorted, we know for sure `it_j->is_squared_dist()`.
+              // Since the map is sorted, we know for sure `j_var.is_squared_dist()`.
               if (eq_i_coeff == eq_j_coeff) {
                 res.emplace_back(SquaredDist(i_var.get_squared_dist()),
-                                 SquaredDist(it_j->get_squared_dist()), 1);
+                                 SquaredDist(j_var.get_squared_dist()), 1);
               }
             }
           }
@@ -221,11 +633,18 @@ namespace Yuclid {
 
   template <typename VarT>
   std::set<VarT> LinearSystem<VarT>::new_found_variables() const {
-    return m_found_variables;
+    std::set<VarT> res;
+    for (VariableId const id : m_found_variables) {
+      res.insert(m_variables.var(id));
+    }
+    return res;
   }
 
   template <typename VarT>
   void LinearSystem<VarT>::clear_new_found_variables() {
+    for (VariableId const id : m_found_variables) {
+      m_states[id].found = false;
+    }
     m_found_variables.clear();
   }
 
@@ -17,13 +17,19 @@
 
 #include "equation.hpp"
 #include "eqn_index.hpp"
+#include "variable_interner.hpp"
+#include "numbers/mod_prime.hpp"
+#include "config_options.hpp"
 #include "typedef.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
 #include <vector>
-#include <map>
-#include <unordered_map>
 #include <set>
 #include <iostream>
-#include <boost/container_hash/hash.hpp>
 
 namespace Yuclid {
   class RatioSquaredDist;
@@ -39,6 +45,38 @@ namespace Yuclid {
    * The class also manages a cache of **found variables** that can be solved for,
    * distinguishing between those already reported to the user and newly discovered ones.
    *
+   * Equations of the form `x - y = c` are the most common ones,
+   * so with `Config::Solver::ar_union_find()` they bypass the echelon form whenever possible.
+   * Instead, they merge classes of a weighted **union-find** structure:
+   * each variable that isn't the representative of its class stores
+   * a linear combination of original equations that proves `x - root = offset`.
+   * Classes are flattened on merge, so finding a representative is a single lookup.
+   * The echelon form only contains representatives,
+   * and a variable that occurs in the echelon form is never absorbed into another class;
+   * if both sides of `x - y = c` occur in it, the equation goes to the echelon form.
+   * The proofs stay valid, but they may use other equations than Gaussian elimination would,
+   * so the union-find is off by default.
+   *
+   * Each variable gets a dense id from `VariableInterner` when it first occurs,
+   * and all tables about variables (pivots, links, classes, watchers etc)
+   * are vectors indexed by these ids.
+   * Equations keep the variables themselves,
+   * so their terms stay sorted in the order of the variables,
+   * e.g., sines before squared distances.
+   * The images of the rows modulo a prime (see below) keep ids instead,
+   * sorted in the same order, so the modular reduction indexes the tables directly.
+   *
+   * The system also keeps the images of the rows modulo the prime `ModPrime::modulus`.
+   * Reducing an equation modulo the prime costs no rational arithmetic,
+   * and tells which variable the exact reduction would get stuck on,
+   * so the exact reduction is needed only when the equation may be solved.
+   *
+   * The pivot of a row is its first term.
+   * When the second term of a row is a pivot too, the row is reduced by its row,
+   * so that values of variables are found as soon as possible.
+   * `Config::EliminationThrottle` may postpone these steps to limit fill-in and coefficient growth;
+   * a postponed step is tried again whenever the row of the second term changes.
+   *
    * @tparam VarT The type of the geometric variable in the equations.
    */
   template <typename VarT>
@@ -53,11 +91,43 @@ namespace Yuclid {
     // Define RHS type based on the VarT, as needed for calculations
     using RHSType = typename EquationTraits<VarT>::RHSType;
 
-    using EchelonFormType =
-      std::unordered_map<VariableType, LinearCombinationType,
-                         boost::hash<VariableType>>;
+    using VariableId = typename VariableInterner<VarT>::Id;
 
   private:
+    /** Marks a variable that has no row in `m_echelon_form` or no link in `m_links`. */
+    static constexpr uint32_t no_row = std::numeric_limits<uint32_t>::max();
+
+    /** Everything the system knows about one variable. */
+    struct VariableState {
+      /** Index of the row of `m_echelon_form` with this pivot, or `no_row`. */
+      uint32_t row{no_row};
+      /** Index of the link of `m_links` from this variable to its representative, or `no_row`. */
+      uint32_t link{no_row};
+      /** Whether the variable occurs in the echelon form, possibly with a zero coefficient by now. */
+      bool in_rows{false};
+      /** Whether the variable is in `m_found_variables`. */
+      bool found{false};
+      /** The version of the system when this variable became a pivot, or 0. */
+      size_t pivoted_at{0};
+      /** The version of the system when the union-find class of this variable last changed, or 0. */
+      size_t linked_at{0};
+      /** Pivots of the rows whose *second* nonzero term has this variable. */
+      std::vector<VariableId> pivots_by_next;
+      /**
+       * Pivots of the rows whose second term is this pivot,
+       * but the elimination throttle didn't let them eliminate it.
+       */
+      std::vector<VariableId> postponed_by_next;
+      /** Other members of the union-find class, if this variable is its representative. */
+      std::vector<VariableId> members;
+      /**
+       * Statements whose reduced equations are stuck on this variable.
+       * They are notified once, when this variable becomes a pivot
+       * or its union-find class is merged with another one.
+       */
+      std::vector<StatementProof *> watchers;
+    };
+
     /** Stores the original equations in the system and the statements that generated them.
      *
      * More precisely, we store iterators to the cache of pending statements
@@ -65,17 +135,95 @@ namespace Yuclid {
      */
     std::vector<std::pair<EquationType, StatementProof *>> m_equations;
 
-    // Row echelon form of the system: pivot variable maps to the echelon form equation
-    // The equation's LHS is a linear combination of original equations, its RHS is also an equation.
-    // The LHS of this equation will contain only equation indices.
-    EchelonFormType m_echelon_form;
+    VariableInterner<VarT> m_variables;
 
-    // Cache of equations in the echelon form whose *second* nonzero term has the key variable.
-    // Maps a variable (potential 'next' term) to a set of pivot variables that have this as their 'next' term.
-    std::map<VariableType, std::set<VariableType>> m_pivot_by_next;
+    /** By variable id. */
+    std::vector<VariableState> m_states;
+
+    // Rows of the echelon form, in the order they were added.
+    // The LHS of a row is a linear combination of original equations,
+    // its RHS is an equation whose first term is the pivot with coefficient 1.
+    std::vector<LinearCombinationType> m_echelon_form;
 
     // Cache of variables that can be found (i.e., solved for).
-    std::set<VariableType> m_found_variables; // Awaiting to be requested
+    std::vector<VariableId> m_found_variables; // Awaiting to be requested
+
+    // Images of the LHS of the rows' RHS modulo `ModPrime::modulus`, by row.
+    // Terms are stored by variable id, in the order of the variables.
+    std::vector<std::vector<std::pair<VariableId, ModPrime>>> m_mod_rows;
+
+    // False if some coefficient had a denominator divisible by the prime,
+    // so the images are not reliable and the modular check always passes.
+    bool m_mod_rows_valid{true};
+
+    mutable size_t m_num_modular_checks{0};
+    mutable size_t m_num_modular_rejections{0};
+
+    Config::EliminationThrottle m_throttle{Config::EliminationThrottle::NONE};
+    bool m_union_find{false};
+    size_t m_num_postponed{0};
+
+    // Incremented whenever a new row or link is added, see `version()`.
+    size_t m_version{0};
+
+    // Links of variables that aren't representatives of their union-find classes.
+    // The link of `var` is a linear combination of original equations whose RHS is `var - root = offset`.
+    std::vector<LinearCombinationType> m_links;
+
+    /**
+     * @brief The id of `var`, adding it to the tables if it's new.
+     *
+     * May invalidate references to `m_states`.
+     */
+    VariableId intern(const VariableType &var);
+
+    /** @brief The state of an interned variable. */
+    VariableState &state(const VariableType &var) {
+      VariableId const id = m_variables.find(var);
+      assert(id != VariableInterner<VarT>::no_id);
+      return m_states[id];
+    }
+
+    /** @brief The state of `var`, or `nullptr` if it never occurred in the system. */
+    [[nodiscard]] const VariableState *find_state(const VariableType &var) const {
+      VariableId const id = m_variables.find(var);
+      return id == VariableInterner<VarT>::no_id ? nullptr : &m_states[id];
+    }
+
+    /**
+     * @brief Recompute the image of the `row`-th row modulo the prime.
+     */
+    void update_mod_row(uint32_t row);
+
+    /**
+     * @brief Add `id` to the found variables, unless it's already there.
+     */
+    void mark_found(VariableId id);
+
+    /**
+     * @brief Add `id` and the other members of its class to the found variables.
+     */
+    void insert_found(VariableId id);
+
+    /**
+     * @brief Notify the statements that watch the variable `id`.
+     */
+    void wake_watchers(VariableId id);
+
+    /**
+     * @brief Merge the classes of the two variables of `lc.rhs()`.
+     *
+     * `lc.rhs()` should be `x - y = c` with both `x` and `y` representatives.
+     *
+     * @return false if both variables occur in the echelon form,
+     * so the equation should be added to the echelon form instead.
+     */
+    bool try_merge_classes(LinearCombinationType lc);
+
+    /**
+     * @brief Whether the elimination throttle lets `e` eliminate its second term using `row`.
+     */
+    [[nodiscard]] bool may_eliminate(const LinearCombinationType &e, const LinearCombinationType &row) const;
 
     /**
      * @brief Reduce the "next" term in a linear equation in place.
@@ -83,8 +231,14 @@ namespace Yuclid {
      * Also add it to the relevant caches.
      *
      * @param e The linear combination equation to reduce.
+     * @return Whether `e` changed.
      */
-    void reduce_next(LinearCombinationType &e);
+    bool reduce_next(LinearCombinationType &e);
+
+    /**
+     * @brief Retry the postponed reductions by the rows of `changed`, and so on.
+     */
+    void reduce_postponed(std::vector<VariableId> changed);
 
   public:
     /**
@@ -92,6 +246,14 @@ namespace Yuclid {
      */
     LinearSystem() = default;
 
+    /**
+     * @brief Initializes an empty linear system with the given elimination throttle.
+     *
+     * @param union_find Whether `x - y = c` equations merge union-find classes.
+     */
+    LinearSystem(Config::EliminationThrottle throttle, bool union_find) :
+      m_throttle(throttle), m_union_find(union_find) {}
+
     /**
      * @brief Adds a reduced equation to the linear system, reducing it modulo existing ones.
      *
@@ -102,6 +264,114 @@ namespace Yuclid {
      */
     void add_reduced_equation(StatementProof *pf);
 
+    /**
+     * @brief Notify `pf` once `var` becomes a pivot variable
+     * or its class is merged with another one.
+     *
+     * Until then, reducing an equation whose remainder contains `var`
+     * may make no progress because of `var`.
+     * The notification fires only once,
+     * so the statement should call this method again
+     * after it fails to make progress.
+     *
+     * @param var The leading variable or a variable of the remainder
+     * of a reduced equation of `pf`.
+     * @param pf The statement to notify.
+     */
+    void watch(const VariableType &var, StatementProof *pf);
+
+    /** @brief Whether `pf` still waits for a notification about `var`, see `watch()`. */
+    [[nodiscard]] bool is_watched_by(const VariableType &var, const StatementProof *pf) const;
+
+    /**
+     * @brief The row of the echelon form with pivot `var`.
+     *
+     * @return A linear combination of original equations whose RHS is `var + ... = rhs`,
+     * or `nullptr` if `var` isn't a pivot.
+     */
+    [[nodiscard]] const LinearCombinationType *pivot_row(const VariableType &var) const {
+      const VariableState *st = find_state(var);
+      return st == nullptr || st->row == no_row ? nullptr : &m_echelon_form[st->row];
+    }
+
+    /**
+     * @brief The number of rows and links added so far.
+     *
+     * Back substitution doesn't change the span of the rows,
+     * so it doesn't change the version.
+     */
+    [[nodiscard]] size_t version() const { return m_version; }
+
+    /**
+     * @brief The version when `var` became a pivot, or 0 if it isn't a pivot.
+     */
+    [[nodiscard]] size_t pivoted_at(const VariableType &var) const {
+      const VariableState *st = find_state(var);
+      return st == nullptr ? 0 : st->pivoted_at;
+    }
+
+    /**
+     * @brief The version when the union-find class of `var` last changed, or 0 if it never did.
+     */
+    [[nodiscard]] size_t linked_at(const VariableType &var) const {
+      const VariableState *st = find_state(var);
+      return st == nullptr ? 0 : st->linked_at;
+    }
+
+    /**
+     * @brief Reduce `lhs` modulo the rows and the links, working modulo a prime.
+     *
+     * Follows the steps of `ReducedEquation::reduce()`:
+     * replaces variables by their representatives,
+     * then eliminates the leading term while it's a pivot.
+     * A combination of the rows reduces to zero modulo the prime,
+     * so if the result is nonzero, then the exact reduction can't solve the equation,
+     * and both stop at the same leading variable,
+     * unless some coefficient of the exact remainder happens to be divisible by the prime.
+     *
+     * @return The leading variable of the reduced `lhs`,
+     * or `nullopt` if it vanishes, i.e., `lhs` may be a combination of the rows.
+     */
+    [[nodiscard]] std::optional<VariableType> modular_leading_variable(const LinearCombination<VarT> &lhs) const;
+
+    /** @brief The number of calls to `modular_leading_variable()`. */
+    [[nodiscard]] size_t num_modular_checks() const { return m_num_modular_checks; }
+
+    /** @brief The number of calls to `modular_leading_variable()` that returned a variable. */
+    [[nodiscard]] size_t num_modular_rejections() const { return m_num_modular_rejections; }
+
+    /** @brief The size of the echelon form, to compare elimination throttles. */
+    struct EchelonStats {
+      size_t num_rows{0};      /**< The number of rows. */
+      size_t num_terms{0};     /**< The number of terms in all rows. */
+      size_t max_height{0};    /**< The largest height of a coefficient, see `rat_height()`. */
+      size_t total_height{0};  /**< The sum of heights of all coefficients. */
+    };
+
+    /** @brief Compute the size of the echelon form. */
+    [[nodiscard]] EchelonStats echelon_stats() const;
+
+    /** @brief The number of back substitution steps postponed by the elimination throttle. */
+    [[nodiscard]] size_t num_postponed() const { return m_num_postponed; }
+
+    /**
+     * @brief Find the union-find class representative of `var`.
+     *
+     * @return A linear combination of original equations whose RHS is `var - root = offset`,
+     * or `nullptr` if `var` is the representative of its class.
+     */
+    [[nodiscard]] const LinearCombinationType *link_to_representative(const VariableType &var) const;
+
+    /**
+     * @brief The value of a variable reported by `new_found_variables()`.
+     */
+    [[nodiscard]] RHSType found_value(const VariableType &var) const;
+
+    /**
+     * @brief The number of variables that were merged into classes of other variables.
+     */
+    [[nodiscard]] size_t num_linked_variables() const { return m_links.size(); }
+
     /**
      * @brief Provides read-only access to an equation at a specific index.
      * @param i The `EqnIndex` of the equation to retrieve.
@@ -125,20 +395,17 @@ namespace Yuclid {
     [[nodiscard]] size_t size() const;
 
     /**
-     * @brief Returns a const reference to the echelon form map.
+     * @brief Returns the rows of the echelon form, in the order they were added.
      * @return A const reference to `m_echelon_form`.
      */
-    const EchelonFormType& echelon_form() const {
+    const std::vector<LinearCombinationType>& echelon_form() const {
       return m_echelon_form;
     }
 
     /**
-     * @brief Returns a const reference to the pivot by next cache.
-     * @return A const reference to `m_pivot_by_next`.
+     * @brief The number of distinct variables that occurred in the system.
      */
-    const std::map<VariableType, std::set<VariableType>>& get_pivot_by_next() const {
-      return m_pivot_by_next;
-    }
+    [[nodiscard]] size_t num_variables() const { return m_variables.size(); }
 
     /**
      * @brief Returns the newly found variables.
@@ -152,7 +419,8 @@ namespace Yuclid {
     /**
      * @brief Generate `ratio_squared_dist` statements that may be true.
      *
-     * This generator looks on the first two terms only,
+     * This generator looks on the first two terms of the echelon form equations
+     * and on the pairs of members of union-find classes,
      * so the generated statements may be false.
      */
     [[nodiscard]]
@@ -164,8 +432,8 @@ namespace Yuclid {
     for (size_t i = 0; i < sys.size(); ++i) {
       out << sys.at(EqnIndex<VarT>(i, &sys)) << '\n';
     }
-    for (const auto& [var, eqn]: sys.echelon_form()) {
-      out << var << ": " << eqn.rhs() << '\n';
+    for (const auto& eqn: sys.echelon_form()) {
+      out << eqn.rhs().lhs().begin()->first << ": " << eqn.rhs() << '\n';
     }
     return out;
   }
@@ -22,6 +22,10 @@
 #include <cassert>
 #include <cmath>     // For std::abs (for integer coefficients)
 #include <boost/log/trivial.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
 
 // Includes for types used in LinearSystem operations
 #include "ar/eqn_index.hpp"
@@ -48,19 +52,39 @@ namespace Yuclid {
   // Reduce method
   template <typename VarT>
   void ReducedEquation<VarT>::reduce() {
+    m_modular_leading_variable.reset();
+    m_reduced_at = m_system->version();
+    // Replace variables by the representatives of their union-find classes.
+    // The echelon form only contains representatives,
+    // so this is needed only once per call.
+    bool substituted = true;
+    while (substituted) {
+      substituted = false;
+      for (const auto &[var, coeff] : m_remainder.lhs()) {
+        const LinearCombinationType *link = m_system->link_to_representative(var);
+        if (link != nullptr) {
+          Rat const c = coeff;
+          m_linear_combination.axpy(c, *link);
+          m_remainder.axpy(-c, link->rhs());
+          substituted = true;
+          break;
+        }
+      }
+    }
 
     while (!m_remainder.lhs().empty()) {
-      auto &[var, coeff] = *(m_remainder.lhs().begin());
+      // Copy, since the reduction below changes this term of the remainder.
+      auto const [var, coeff] = *(m_remainder.lhs().begin());
 
       // Check if this variable is a pivot in the echelon form
-      auto echelon_it = m_system->echelon_form().find(var);
-        
+      const LinearCombinationType *pivot_row = m_system->pivot_row(var);
+
       // If a pivot is found for the leading variable of the remainder, reduce it.
       // Otherwise, no further reduction is possible with current echelon form.
-      if (echelon_it != m_system->echelon_form().end()) {
-        const LinearCombinationType& pivot_eq_lc = echelon_it->second; // Equation<EqnIndex<VarT>>
-        m_linear_combination += coeff * pivot_eq_lc; // LC_new = coeff + factor * pivot_indices
-        m_remainder -= coeff * pivot_eq_lc.rhs(); // R_new = R_old - coeff * pivot_equation_content
+      if (pivot_row != nullptr) {
+        const LinearCombinationType& pivot_eq_lc = *pivot_row; // Equation<EqnIndex<VarT>>
+        m_linear_combination.axpy(coeff, pivot_eq_lc); // LC_new = coeff + factor * pivot_indices
+        m_remainder.axpy(-coeff, pivot_eq_lc.rhs()); // R_new = R_old - coeff * pivot_equation_content
       } else {
         // No pivot found for the leading variable, cannot reduce further.
         // Break the reduction loop.
@@ -69,6 +93,44 @@ namespace Yuclid {
     }
   }
 
+  template <typename VarT>
+  bool ReducedEquation<VarT>::reduce_if_solvable() {
+    if (m_remainder.lhs().empty()) {
+      return is_solved();
+    }
+    if (is_up_to_date()) {
+      return false;
+    }
+    optional<VarT> lead = m_system->modular_leading_variable(m_remainder.lhs());
+    if (lead.has_value()) {
+      m_modular_leading_variable = std::move(lead);
+      m_reduced_at = m_system->version();
+      return false;
+    }
+    reduce();
+    return is_solved();
+  }
+
+  template <typename VarT>
+  bool ReducedEquation<VarT>::is_up_to_date() const {
+    if (!m_reduced_at.has_value()) {
+      return false;
+    }
+    size_t const version = *m_reduced_at;
+    if (version == m_system->version()) {
+      return true;
+    }
+    // After a skipped exact reduction, the remainder may not contain this variable.
+    optional<VarT> const lead = leading_variable();
+    if (lead.has_value() &&
+        (m_system->pivoted_at(*lead) > version || m_system->linked_at(*lead) > version)) {
+      return false;
+    }
+    return ranges::none_of(m_remainder.lhs(), [this, version](const auto &term) {
+      return m_system->linked_at(term.first) > version;
+    });
+  }
+
   template <typename VarT>
   bool ReducedEquation<VarT>::is_solved() const {
     if constexpr (is_same_v<typename LinearSystem<VarT>::RHSType, AddCircle<Rat>>) {
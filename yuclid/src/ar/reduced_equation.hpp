@@ -55,6 +55,18 @@ namespace Yuclid {
     // m_coefficient is now in the base class conditionally and is private there.
     LinearCombinationType m_linear_combination; /**< The linear combination of previous equations from the system. */
     EquationType m_remainder;                    /**< The remainder of the original equation after reduction. */
+    /** The leading variable found by the last modular reduction, if the exact one was skipped. */
+    std::optional<VarT> m_modular_leading_variable;
+    /** The version of `m_system` at the last reduction, if any. */
+    std::optional<size_t> m_reduced_at;
+
+    /**
+     * @brief Whether reducing the remainder again would get stuck on the same variable.
+     *
+     * This is the case if the system has no new pivot at the leading variable
+     * and no new links from the variables of the remainder since the last reduction.
+     */
+    [[nodiscard]] bool is_up_to_date() const;
 
   public:
     /**
@@ -100,6 +112,9 @@ namespace Yuclid {
      * @brief Reduces the `m_remainder` by eliminating its leading terms using
      * equations from the global `LinearSystem`'s echelon form.
      *
+     * First, all variables are replaced by the representatives
+     * of their union-find classes in the `LinearSystem`.
+     *
      * This method iteratively applies reduction steps, modifying `m_remainder`
      * and `m_linear_combination_of_indices` to maintain the invariant.
      * The process continues until the `m_remainder`'s LHS is empty or
@@ -107,11 +122,47 @@ namespace Yuclid {
      */
     void reduce();
 
+    /**
+     * @brief Reduce the equation if the system may solve it.
+     *
+     * If the remainder got stuck on a variable before,
+     * and since then this variable didn't become a pivot
+     * and no variable of the remainder got a new representative,
+     * then the system still can't solve it, so nothing is done.
+     * Indeed, a nonzero combination of rows starts with a pivot,
+     * so a new row helps only if its pivot is the leading variable of the remainder.
+     *
+     * Otherwise, first reduces the remainder modulo a prime,
+     * see `LinearSystem::modular_leading_variable()`.
+     * If it doesn't vanish, the exact reduction can't solve the equation,
+     * so it is skipped and `m_remainder` is left as is.
+     *
+     * @return Whether the equation is solved.
+     */
+    bool reduce_if_solvable();
+
     /**
      * @brief Check if the reduced equation is solved.
      */
     [[nodiscard]] bool is_solved() const;
 
+    /**
+     * @brief The leading variable of the remainder after the last reduction,
+     * or `nullopt` if the remainder has no variables.
+     *
+     * If the last call to `reduce_if_solvable()` skipped the exact reduction,
+     * this is the variable the exact reduction would be stuck on.
+     */
+    [[nodiscard]] std::optional<VarT> leading_variable() const {
+      if (m_modular_leading_variable.has_value()) {
+        return m_modular_leading_variable;
+      }
+      if (m_remainder.lhs().empty()) {
+        return std::nullopt;
+      }
+      return m_remainder.lhs().begin()->first;
+    }
+
     [[nodiscard]] auto statement_dependencies() const {
       return m_linear_combination.lhs()
         | std::views::transform([this](const auto &term) {
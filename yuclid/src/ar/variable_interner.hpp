@@ -0,0 +1,77 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Yuclid {
+
+  /**
+   * @brief Assigns dense integer ids to the variables of a `LinearSystem`.
+   *
+   * Ids are assigned in the order the variables are first seen,
+   * so they don't follow the order of the variables;
+   * equations keep the variables themselves and stay sorted by them.
+   * Tables indexed by variables use ids instead,
+   * so each variable is hashed once per lookup
+   * and the rest of the work is indexing into vectors.
+   *
+   * @tparam VarT The type of the geometric variable.
+   */
+  template <typename VarT>
+  class VariableInterner final {
+  public:
+    using Id = uint32_t;
+
+    /** @brief The id returned by `find()` for a variable that was never interned. */
+    static constexpr Id no_id = std::numeric_limits<Id>::max();
+
+    /** @brief The id of `var`; assigns the next id if `var` is new. */
+    Id intern(const VarT &var) {
+      auto [it, inserted] = m_ids.try_emplace(var, static_cast<Id>(m_vars.size()));
+      if (inserted) {
+        assert(m_vars.size() < no_id);
+        m_vars.push_back(var);
+      }
+      return it->second;
+    }
+
+    /** @brief The id of `var`, or `no_id` if it was never interned. */
+    [[nodiscard]] Id find(const VarT &var) const {
+      auto it = m_ids.find(var);
+      return it == m_ids.end() ? no_id : it->second;
+    }
+
+    /** @brief The variable with id `id`. */
+    [[nodiscard]] const VarT &var(Id id) const {
+      assert(id < m_vars.size());
+      return m_vars[id];
+    }
+
+    /** @brief The number of interned variables; ids are `0, ..., size() - 1`. */
+    [[nodiscard]] size_t size() const { return m_vars.size(); }
+
+  private:
+    boost::unordered_flat_map<VarT, Id, boost::hash<VarT>> m_ids;
+    std::vector<VarT> m_vars;
+  };
+
+}
@@ -0,0 +1,71 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "buckets.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <format>
+#include <string>
+
+using namespace std;
+
+namespace Yuclid {
+
+  void BucketStats::add(size_t size) {
+    size_t const bin = min<size_t>(bit_width(size) - 1, num_bins - 1);
+    m_bins[bin].fetch_add(1, memory_order_relaxed); // NOLINT(*-constant-array-index)
+    size_t prev = m_max_size.load(memory_order_relaxed);
+    while (prev < size && !m_max_size.compare_exchange_weak(prev, size, memory_order_relaxed)) {
+    }
+  }
+
+  size_t BucketStats::num_buckets() const {
+    size_t res = 0;
+    for (const auto &count : m_bins) {
+      res += count.load(memory_order_relaxed);
+    }
+    return res;
+  }
+
+  string BucketStats::to_string() const {
+    string res;
+    for (size_t ind = 0; ind < num_bins; ++ ind) {
+      size_t const count = bin(ind);
+      if (count == 0) {
+        continue;
+      }
+      if (!res.empty()) {
+        res += ", ";
+      }
+      size_t const from = size_t{1} << ind;
+      if (ind == 0) {
+        res += format("1: {}", count);
+      } else if (ind + 1 == num_bins) {
+        res += format("{}+: {}", from, count);
+      } else {
+        res += format("{}-{}: {}", from, 2 * from - 1, count);
+      }
+    }
+    if (res.empty()) {
+      res = "no buckets";
+    }
+    res += format("; largest {}, {} split(s)", max_size(), num_splits());
+    return res;
+  }
+
+}
@@ -0,0 +1,163 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "numbers/util.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Yuclid {
+
+  /**
+   * @brief Histogram of the sizes of the buckets produced by `foreach_bucket`.
+   *
+   * Bin `k` counts the buckets with `2^k ≤ size < 2^(k + 1)`;
+   * the last bin also counts all larger buckets.
+   * Buckets may be added from several threads at the same time.
+   */
+  class BucketStats final {
+  public:
+    static constexpr size_t num_bins = 16;
+
+    /** @brief Count a bucket of `size` items. */
+    void add(size_t size);
+
+    /** @brief Count a bucket that was split because its keys drifted too far. */
+    void add_split() { m_splits.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] size_t num_buckets() const;
+
+    [[nodiscard]] size_t num_splits() const { return m_splits.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] size_t max_size() const { return m_max_size.load(std::memory_order_relaxed); }
+
+    /** @brief The number of buckets in the `bin`-th bin. */
+    [[nodiscard]] size_t bin(size_t bin) const {
+      return m_bins[bin].load(std::memory_order_relaxed); // NOLINT(*-constant-array-index)
+    }
+
+    /** @brief Nonempty bins in the form `1: 20, 2-3: 4, 4-7: 1`, the largest size, and the number of splits. */
+    [[nodiscard]] std::string to_string() const;
+
+  private:
+    std::array<std::atomic<size_t>, num_bins> m_bins{};
+    std::atomic<size_t> m_splits{0};
+    std::atomic<size_t> m_max_size{0};
+  };
+
+  /**
+   * @brief The largest difference between the keys of items in the same bucket.
+   *
+   * Equal keys computed in different ways differ by much less than `EPS`,
+   * so a bucket this wide is a chain of distinct values.
+   */
+  const double MAX_BUCKET_DIAMETER = 10 * EPS;
+
+  /**
+   * @brief Split sorted `items` into buckets of approximately equal keys
+   * and call `callback` on each bucket.
+   *
+   * Consecutive items go to the same bucket if their keys differ by less than `EPS`.
+   * A bucket is split before an item whose key exceeds the first key of the bucket
+   * by `MAX_BUCKET_DIAMETER` or more, so slowly drifting keys can't chain
+   * many unrelated items into one bucket.
+   * Such a split may fall between equal keys,
+   * so the next bucket also starts with the items of the previous one
+   * whose keys are less than `EPS` below the key of the split.
+   * Combinations of these items are passed to `callback` twice,
+   * e.g., the theorem stream deduplicates the theorems matched on them.
+   *
+   * If `stats` isn't null, the sizes of the buckets and the splits are counted there.
+   */
+  template<class VectorType, class KeyFunType, class CallbackType>
+  requires
+    (std::is_invocable_r_v<double, KeyFunType, typename VectorType::value_type>
+    || std::is_invocable_r_v<double, KeyFunType, const typename VectorType::value_type&>)
+    && (std::is_invocable_r_v<void, CallbackType, std::span<typename VectorType::value_type>>
+    || std::is_invocable_r_v<void, CallbackType, std::span<const typename VectorType::value_type>>)
+  void foreach_bucket(VectorType& items,
+                      KeyFunType key_fun,
+                      const CallbackType& callback,
+                      BucketStats *stats = nullptr) {
+    // Determine the element type of the span based on the constness of vector_type
+    using ItemType = typename VectorType::value_type;
+    using SpanElementType =
+      std::conditional_t<std::is_const_v<std::remove_reference_t<VectorType>>,
+                         const ItemType,
+                         ItemType>;
+
+    if (items.empty()) {
+      return;
+    }
+    auto emit = [&items, &callback, stats](size_t from, size_t to) {
+      if (stats != nullptr) {
+        stats->add(to - from);
+      }
+      callback(std::span<SpanElementType>(items).subspan(from, to - from));
+    };
+    size_t start_bucket_index = 0;
+    double start_bucket_key = std::invoke(key_fun, items[0]);
+    double last_key = start_bucket_key;
+    for (size_t ind = 1; ind < items.size(); ++ ind) {
+      double const key = std::invoke(key_fun, items[ind]);
+      bool const close = key < last_key + EPS;
+      bool const drifted = key >= start_bucket_key + MAX_BUCKET_DIAMETER;
+      if (!close || drifted) {
+        emit(start_bucket_index, ind);
+        size_t next_start = ind;
+        if (close) {
+          if (stats != nullptr) {
+            stats->add_split();
+          }
+          // The first key of the bucket is at least `MAX_BUCKET_DIAMETER` below `key`,
+          // so the bucket is never repeated whole.
+          while (std::invoke(key_fun, items[next_start - 1]) > key - EPS) {
+            -- next_start;
+          }
+        }
+        start_bucket_index = next_start;
+        start_bucket_key = key;
+      }
+      last_key = key;
+    }
+    emit(start_bucket_index, items.size());
+  }
+
+  /**
+   * @brief Split sorted `items` into buckets of approximately equal keys.
+   *
+   * Same as `foreach_bucket` but returns the buckets instead of processing them,
+   * so that we can process them in parallel.
+   */
+  template<class VectorType, class KeyFunType>
+  auto all_buckets(VectorType& items, KeyFunType key_fun, BucketStats *stats = nullptr) {
+    using SpanType =
+      std::span<std::conditional_t<std::is_const_v<std::remove_reference_t<VectorType>>,
+                                   const typename VectorType::value_type,
+                                   typename VectorType::value_type>>;
+    std::vector<SpanType> res;
+    foreach_bucket(items, key_fun, [&res](SpanType bucket) {
+      res.push_back(bucket);
+    }, stats);
+    return res;
+  }
+
+}
@@ -0,0 +1,132 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "circle_registry.hpp"
+
+#include "type/point.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  namespace {
+    /** Pack the sorted indexes of `points`, 16 bits each. */
+    template <size_t N>
+    uint64_t sorted_key(array<Point, N> points) {
+      static_assert(N <= 4);
+      ranges::sort(points);
+      uint64_t res = 0;
+      for (const Point &pt : points) {
+        res = (res << 16U) | pt.get();
+      }
+      return res;
+    }
+  }
+
+  void CircleRegistry::add_required_points(const vector<Point> &points) {
+    vector<Point> pts = points;
+    ranges::sort(pts);
+    auto const [first, last] = ranges::unique(pts);
+    pts.erase(first, last);
+    size_t const size = pts.size();
+    for (size_t i = 0; i < size; ++ i) {
+      for (size_t j = i + 1; j < size; ++ j) {
+        for (size_t k = j + 1; k < size; ++ k) {
+          m_required.insert(sorted_key(array{pts[i], pts[j], pts[k]}));
+          for (size_t l = k + 1; l < size; ++ l) {
+            m_required.insert(sorted_key(array{pts[i], pts[j], pts[k], pts[l]}));
+          }
+        }
+      }
+    }
+  }
+
+  bool CircleRegistry::uses_triangle(size_t i, size_t size, const array<Point, 3> &points) const {
+    return size <= max_full_size || i == 0 || m_required.contains(sorted_key(points));
+  }
+
+  bool CircleRegistry::uses_quadrangle(size_t i, size_t j, size_t size,
+                                       const array<Point, 4> &points) const {
+    return size <= max_full_size || (i == 0 && j == 1) || m_required.contains(sorted_key(points));
+  }
+
+  void CircleRegistry::add_quadrangle(const array<Point, 4> &points) {
+    array<Point, 4> sorted = points;
+    ranges::sort(sorted);
+    m_quadrangles.push_back(sorted);
+  }
+
+  vector<vector<Point>> CircleRegistry::circles() const {
+    // Union-find over quadrangles, two quadrangles that share a triple of points
+    // lie on the same circle.
+    vector<size_t> parent(m_quadrangles.size());
+    iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t ind) {
+      while (parent[ind] != ind) {
+        parent[ind] = parent[parent[ind]];
+        ind = parent[ind];
+      }
+      return ind;
+    };
+    boost::unordered_flat_map<uint64_t, size_t> by_triple;
+    for (size_t ind = 0; ind < m_quadrangles.size(); ++ ind) {
+      const auto &quad = m_quadrangles[ind];
+      for (size_t skip = 0; skip < quad.size(); ++ skip) {
+        array<Point, 3> triple{quad[0], quad[1], quad[2]};
+        for (size_t pos = 0, out = 0; pos < quad.size(); ++ pos) {
+          if (pos != skip) {
+            triple[out ++] = quad[pos];
+          }
+        }
+        uint64_t const key = sorted_key(triple);
+        auto [it, inserted] = by_triple.try_emplace(key, ind);
+        if (!inserted) {
+          size_t const root_old = find(it->second);
+          size_t const root_new = find(ind);
+          // Keep the smaller index as the root, so that the result is deterministic.
+          parent[max(root_old, root_new)] = min(root_old, root_new);
+        }
+      }
+    }
+
+    vector<vector<Point>> res;
+    vector<size_t> circle_of_root(m_quadrangles.size(), m_quadrangles.size());
+    for (size_t ind = 0; ind < m_quadrangles.size(); ++ ind) {
+      size_t const root = find(ind);
+      if (circle_of_root[root] == m_quadrangles.size()) {
+        circle_of_root[root] = res.size();
+        res.emplace_back();
+      }
+      auto &circle = res[circle_of_root[root]];
+      circle.insert(circle.end(), m_quadrangles[ind].begin(), m_quadrangles[ind].end());
+    }
+    for (auto &circle : res) {
+      ranges::sort(circle);
+      auto const [first, last] = ranges::unique(circle);
+      circle.erase(first, last);
+    }
+    ranges::sort(res);
+    return res;
+  }
+
+}
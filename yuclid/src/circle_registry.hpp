@@ -0,0 +1,87 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <array>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/point.hpp"
+
+namespace Yuclid {
+
+  /**
+   * @brief Circles through points of a problem.
+   *
+   * The theorem matcher finds concyclic quadrangles one by one,
+   * e.g., from pairs of equal angles.
+   * The registry merges quadrangles that share three points into circles,
+   * so that the theorems about a circle are generated once per circle.
+   *
+   * It also decides which triangles and quadrangles of a circle
+   * get theorems about them.
+   * Small circles use all of them.
+   * For larger circles, we use the triangles through the first point
+   * and the quadrangles through the first two points.
+   * These quadrangles are enough to express every inscribed angle
+   * in terms of the chords through the first two points,
+   * so the equal angles of other quadrangles follow by angle chasing.
+   * Since statements about the other quadrangles can't be recognized this way,
+   * the triangles and quadrangles formed by the points of a goal are always used.
+   */
+  class CircleRegistry final {
+  public:
+    /** @brief Circles with at most this many points use all triangles and quadrangles. */
+    static constexpr size_t max_full_size = 7;
+
+    /**
+     * @brief Always use the triangles and quadrangles formed by `points`,
+     * e.g., the points of a goal.
+     */
+    void add_required_points(const std::vector<Point> &points);
+
+    /** @brief Record that four distinct points are concyclic. */
+    void add_quadrangle(const std::array<Point, 4> &points);
+
+    /**
+     * @brief Merge the recorded quadrangles into circles.
+     *
+     * @return Sorted lists of points on each circle,
+     * ordered by their first points.
+     */
+    [[nodiscard]] std::vector<std::vector<Point>> circles() const;
+
+    /**
+     * @brief Whether the triangle formed by the points
+     * at positions `i < j < k` of a circle with `size` points gets theorems.
+     */
+    [[nodiscard]] bool uses_triangle(size_t i, size_t size, const std::array<Point, 3> &points) const;
+
+    /**
+     * @brief Whether the quadrangle formed by the points
+     * at positions `i < j < k < l` of a circle with `size` points gets theorems.
+     */
+    [[nodiscard]] bool uses_quadrangle(size_t i, size_t j, size_t size,
+                                       const std::array<Point, 4> &points) const;
+
+  private:
+    std::vector<std::array<Point, 4>> m_quadrangles;
+    /** Keys of the sorted triangles and quadrangles that are always used. */
+    boost::unordered_flat_set<uint64_t> m_required;
+  };
+
+}
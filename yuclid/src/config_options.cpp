@@ -24,10 +24,12 @@
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/program_options.hpp> // NOLINT
 #include <boost/program_options/options_description.hpp>
+#include <algorithm>
 #include <iostream>
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace po = boost::program_options;
 
@@ -43,6 +45,8 @@ namespace Yuclid {
       mode = Config::Mode::DDAR;
     } else if (str == "match") {
       mode = Config::Mode::MATCH;
+    } else if (str == "serve") {
+      mode = Config::Mode::SERVE;
     } else {
       throw po::validation_error(po::validation_error::invalid_option_value, "mode", str);
     }
@@ -55,6 +59,58 @@ namespace Yuclid {
       return out << "ddar";
     case Config::Mode::MATCH:
       return out << "match";
+    case Config::Mode::SERVE:
+      return out << "serve";
+    }
+    return out;
+  }
+
+  std::istream& operator>>(std::istream& input, Config::Scheduler& scheduler) {
+    std::string str;
+    input >> str;
+    if (str == "level") {
+      scheduler = Config::Scheduler::LEVEL;
+    } else if (str == "watch") {
+      scheduler = Config::Scheduler::WATCH;
+    } else {
+      throw po::validation_error(po::validation_error::invalid_option_value, "scheduler", str);
+    }
+    return input;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const Config::Scheduler &scheduler) {
+    switch (scheduler) {
+    case Config::Scheduler::LEVEL:
+      return out << "level";
+    case Config::Scheduler::WATCH:
+      return out << "watch";
+    }
+    return out;
+  }
+
+  std::istream& operator>>(std::istream& input, Config::EliminationThrottle& throttle) {
+    std::string str;
+    input >> str;
+    if (str == "none") {
+      throttle = Config::EliminationThrottle::NONE;
+    } else if (str == "least-fill") {
+      throttle = Config::EliminationThrottle::LEAST_FILL;
+    } else if (str == "min-height") {
+      throttle = Config::EliminationThrottle::MIN_HEIGHT;
+    } else {
+      throw po::validation_error(po::validation_error::invalid_option_value, "ar-throttle", str);
+    }
+    return input;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const Config::EliminationThrottle &throttle) {
+    switch (throttle) {
+    case Config::EliminationThrottle::NONE:
+      return out << "none";
+    case Config::EliminationThrottle::LEAST_FILL:
+      return out << "least-fill";
+    case Config::EliminationThrottle::MIN_HEIGHT:
+      return out << "min-height";
     }
     return out;
   }
@@ -87,10 +143,14 @@ namespace Yuclid {
        "Use json for output. Currently, only used in `--mode=match`")
       ("input-file", po::value<std::vector<std::string>>(&m_input_file_paths)->multitoken(),
        "Input file paths. If not specified, standard input (std::cin) is used.")
+      ("jobs", po::value<size_t>(&m_num_jobs)->default_value(1),
+       "Number of input files solved concurrently, 0 means all hardware threads. "
+       "If it isn't 1, then the outputs are printed in the order of input files "
+       "after all of them are solved, followed by a summary on stderr. Default: 1.")
       ("log-level", po::value<boost::log::trivial::severity_level>(&m_log_level)->default_value(boost::log::trivial::info),
        "Set the minimum logging severity level (trace, debug, info, warning, error, fatal). Default: info.")
       ("mode", po::value<Mode>(&m_mode)->implicit_value(Mode::DDAR),
-       "Operation mode. One of `ddar`, `datagen`, `match`. Default: `ddar`.");
+       "Operation mode. One of `ddar`, `match`, `serve`. Default: `ddar`.");
     return desc;
   }
 
@@ -104,11 +164,35 @@ namespace Yuclid {
       ("disable-eqn-statements", po::bool_switch(&m_disable_eqn_statements),
        "Disable theorems with equations as hypotheses/conclusions (default: enabled)")
       ("disable-ar-sin", po::bool_switch(&m_disable_ar_sin),
-       "Disable use of sines (recommended for now)");
+       "Disable use of sines (recommended for now)")
+      ("sparse-collinear", po::bool_switch(&m_sparse_collinear),
+       "Match theorems about collinear points only for the triples "
+       "through the first two points of each line, "
+       "instead of all collinear triples (default: no)")
+      ("scheduler", po::value<Scheduler>(&m_scheduler)->default_value(Scheduler::WATCH),
+       "How to choose theorems to advance on each level. "
+       "One of `level` (go over all theorems), `watch` (only woken up theorems). Default: `watch`.")
+      ("ar-throttle", po::value<EliminationThrottle>(&m_elimination_throttle)->default_value(EliminationThrottle::NONE),
+       "Which back substitution steps AR tables postpone to keep rows short. "
+       "One of `none`, `least-fill` (the steps that make a row longer), "
+       "`min-height` (the steps that make its coefficients larger). Default: `none`. "
+       "Pivots are the same; the goals in the span of the tables are still proved, "
+       "but values of variables behind a postponed step aren't found, "
+       "so `lconst`/`aconst`/`rconst` statements and the theorems that need them may be lost.")
+      ("ar-union-find", po::bool_switch(&m_ar_union_find),
+       "Resolve AR equations `x - y = c` with a union-find instead of Gaussian elimination. "
+       "Faster on long angle and ratio chases, but the proofs may use other premises (default: no)")
+      ("threads", po::value<size_t>(&m_num_threads)->default_value(1),
+       "Number of threads used to match theorems, 0 means all hardware threads. "
+       "The matched theorems don't depend on this number. Default: 1.");
     return desc;
   }
 
-  Config::Config(int argc, char* argv[]) {
+  Config::Config(int argc, char* argv[])
+    : Config(std::vector<std::string>(argv + std::min(argc, 1), argv + argc)) { // NOLINT(*-pointer-arithmetic)
+  }
+
+  Config::Config(const std::vector<std::string> &args) {
 
     // Define the command-line options using Boost.Program_options.
     po::options_description desc("Allowed options");
@@ -119,7 +203,7 @@ namespace Yuclid {
 
     po::variables_map vars;
     try {
-      po::store(po::command_line_parser(argc, argv).
+      po::store(po::command_line_parser(args).
                 options(desc).positional(positional).run(), vars);
       po::notify(vars);
     } catch (const po::error& e) {
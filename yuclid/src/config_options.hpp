@@ -18,6 +18,7 @@
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/program_options/options_description.hpp>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -41,14 +42,49 @@ namespace Yuclid {
     /**
      * @brief Mode of operation for the application.
      *
-     * Currently, only two modes are available:
+     * Currently, three modes are available:
      *
      * - run DD/AR on the problem(s);
-     * - numerically match theorems and print the matches.
+     * - numerically match theorems and print the matches;
+     * - read JSON requests from the standard input, one per line,
+     *   and answer each of them with a line of JSON.
      */
     enum class Mode : uint8_t {
       DDAR,    //< Run DD/AR on a problem (default)
       MATCH,   //< Match all theorems and print them
+      SERVE,   //< Answer NDJSON requests on stdin until EOF
+    };
+
+    /**
+     * @brief Strategy for choosing theorems to advance on each level.
+     *
+     * Both strategies establish the same statements in the same order,
+     * so `LEVEL` is mostly useful as a reference implementation.
+     */
+    enum class Scheduler : uint8_t {
+      LEVEL,   //< Go over all pending theorems on each level
+      WATCH,   //< Only revisit theorems whose watched statements changed (default)
+    };
+
+    /**
+     * @brief Which back substitution steps AR tables postpone.
+     *
+     * This doesn't choose pivots: the pivot of a row is always its first term,
+     * so that sines stay pivots before squared distances.
+     * If the second term is a pivot too, the row may be reduced by its row.
+     * This back substitution finds new values of variables,
+     * but it may make the row longer and its coefficients larger.
+     * The throttles postpone such steps until the row of the second term changes,
+     * which may never happen.
+     * The rows span the same equations, so the same goals are in the span,
+     * but a variable whose row keeps a postponed term never gets its value,
+     * so the statements deduced from values (e.g., `lconst`, `aconst`, `rconst`)
+     * and the theorems waiting for them may be lost.
+     */
+    enum class EliminationThrottle : uint8_t {
+      NONE,        //< Always eliminate the second term (default)
+      LEAST_FILL,  //< Only if the row doesn't get longer
+      MIN_HEIGHT,  //< Only if the largest coefficient height doesn't grow
     };
 
     /**
@@ -70,6 +106,11 @@ namespace Yuclid {
 
       [[nodiscard]] bool err_on_failure() const { return m_err_on_failure; }
 
+      /**
+       * @brief Number of input files solved concurrently, 0 means all hardware threads.
+       */
+      [[nodiscard]] size_t num_jobs() const { return m_num_jobs; }
+
       /**
        * @brief An `options_description` object that can be used to initialize `this`.
        */
@@ -81,6 +122,7 @@ namespace Yuclid {
       bool m_use_json = false;
       std::vector<std::string> m_input_file_paths;
       bool m_err_on_failure = false;
+      size_t m_num_jobs = 1;
     };
 
     /**
@@ -100,6 +142,30 @@ namespace Yuclid {
         return !m_disable_eqn_statements;
       }
 
+      /**
+       * @brief Whether to match `coll`/`para` theorems
+       * only for a spanning set of triples on each line, see `LineRegistry`.
+       */
+      [[nodiscard]] bool sparse_collinear() const { return m_sparse_collinear; }
+
+      [[nodiscard]] Scheduler scheduler() const { return m_scheduler; }
+
+      [[nodiscard]] EliminationThrottle elimination_throttle() const { return m_elimination_throttle; }
+
+      /**
+       * @brief Whether AR tables resolve `x - y = c` equations with a union-find, see `LinearSystem`.
+       *
+       * The proofs may use other premises than with Gaussian elimination only.
+       */
+      [[nodiscard]] bool ar_union_find() const { return m_ar_union_find; }
+
+      /**
+       * @brief Number of threads used to match theorems.
+       *
+       * Zero means all hardware threads.
+       */
+      [[nodiscard]] size_t num_threads() const { return m_num_threads; }
+
       /**
        * @brief An `options_description` object that can be used to initialize `this`.
        */
@@ -110,6 +176,11 @@ namespace Yuclid {
       bool m_disable_ar_squared = false;
       bool m_disable_ar_sin = true;
       bool m_disable_eqn_statements = false;
+      bool m_sparse_collinear = false;
+      Scheduler m_scheduler = Scheduler::WATCH;
+      EliminationThrottle m_elimination_throttle = EliminationThrottle::NONE;
+      bool m_ar_union_find = false;
+      size_t m_num_threads = 1;
     };
 
     /**
@@ -117,6 +188,13 @@ namespace Yuclid {
      */
     Config(int argc, char *argv[]); // NOLINT(*-avoid-c-arrays)
 
+    /**
+     * @brief Build a `Config` object from a list of command line arguments.
+     *
+     * Unlike `argv`, `args` doesn't include the name of the program.
+     */
+    explicit Config(const std::vector<std::string> &args);
+
     [[nodiscard]] const Global &global() const { return m_global; }
     [[nodiscard]] const Solver &solver() const { return m_solver; }
   private:
@@ -136,6 +214,26 @@ namespace Yuclid {
    */
   std::ostream &operator<<(std::ostream &out, const Config::Mode &mode);
 
+  /**
+   * @brief Operator to stream a Scheduler enum from an istream.
+   */
+  std::istream& operator>>(std::istream& input, Config::Scheduler& scheduler);
+
+  /**
+   * @brief Operator to stream a Scheduler enum to an ostream.
+   */
+  std::ostream &operator<<(std::ostream &out, const Config::Scheduler &scheduler);
+
+  /**
+   * @brief Operator to stream an EliminationThrottle enum from an istream.
+   */
+  std::istream& operator>>(std::istream& input, Config::EliminationThrottle& throttle);
+
+  /**
+   * @brief Operator to stream an EliminationThrottle enum to an ostream.
+   */
+  std::ostream &operator<<(std::ostream &out, const Config::EliminationThrottle &throttle);
+
   extern template bool Config::Solver::ar_enabled<Dist>() const;
   extern template bool Config::Solver::ar_enabled<SquaredDist>() const;
 } // namespace Yuclid
@@ -0,0 +1,55 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "geometry_cache.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+
+using namespace std;
+
+namespace Yuclid {
+
+  void GeometryCache::add_point(double x, double y) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_table_size = 0;
+    m_squared_dist = Table();
+    m_dist = Table();
+    m_slope = Table();
+  }
+
+  void GeometryCache::build_tables() {
+    size_t const num_pts = m_x.size();
+    double const nan = numeric_limits<double>::quiet_NaN();
+    for (Table *table : {&m_squared_dist, &m_dist, &m_slope}) {
+      *table = Table(num_pts * num_pts);
+      for (auto &entry : *table) {
+        entry.store(nan, memory_order_relaxed);
+      }
+    }
+    m_table_size = num_pts;
+  }
+
+  double GeometryCache::slope(size_t i, size_t j) const {
+    return lookup(m_slope, i, j, [this, i, j]() {
+      // `atan2` returns angle in radians in range (-pi, pi].
+      return atan2(y(j) - y(i), x(j) - x(i)) / numbers::pi_v<double>;
+    });
+  }
+
+}
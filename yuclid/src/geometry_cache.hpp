@@ -0,0 +1,118 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Yuclid {
+
+  /**
+   * @brief Numerical data about the points of a problem.
+   *
+   * Stores the coordinates of the points in contiguous arrays,
+   * and `n × n` tables of distances, squared distances, and slopes
+   * that are filled lazily on first access.
+   *
+   * The tables are allocated by `build_tables()`,
+   * which should be called once all points are added.
+   * Before that, all values are computed from scratch.
+   *
+   * Lookups are thread-safe: concurrent readers may compute the same entry twice,
+   * but they store the same value.
+   */
+  class GeometryCache final {
+  public:
+    GeometryCache() = default;
+
+    /**
+     * @brief Append a point. Discards the tables, if any.
+     */
+    void add_point(double x, double y);
+
+    /**
+     * @brief Allocate empty tables for the current set of points.
+     */
+    void build_tables();
+
+    /** @brief Number of points. */
+    [[nodiscard]] size_t size() const { return m_x.size(); }
+
+    [[nodiscard]] double x(size_t i) const {
+      assert(i < m_x.size());
+      return m_x[i];
+    }
+
+    [[nodiscard]] double y(size_t i) const {
+      assert(i < m_y.size());
+      return m_y[i];
+    }
+
+    /** @brief Squared distance between the `i`th and the `j`th points. */
+    [[nodiscard]] double squared_dist(size_t i, size_t j) const {
+      return lookup(m_squared_dist, i, j, [this, i, j]() {
+        double const dx = x(j) - x(i);
+        double const dy = y(j) - y(i);
+        return (dx * dx) + (dy * dy);
+      });
+    }
+
+    /** @brief Distance between the `i`th and the `j`th points. */
+    [[nodiscard]] double dist(size_t i, size_t j) const {
+      return lookup(m_dist, i, j, [this, i, j]() {
+        return std::sqrt(squared_dist(i, j));
+      });
+    }
+
+    /**
+     * @brief Direction of the vector from the `i`th point to the `j`th point.
+     *
+     * @return The angle between the vector and the `x` axis, divided by `π`,
+     * in `(-1, 1]`.
+     */
+    [[nodiscard]] double slope(size_t i, size_t j) const;
+
+  private:
+    using Table = std::vector<std::atomic<double>>;
+
+    template <typename Fun>
+    double lookup(Table &table, size_t i, size_t j, const Fun &compute) const {
+      if (m_table_size != m_x.size()) [[unlikely]] {
+        return compute();
+      }
+      assert(i < m_table_size && j < m_table_size);
+      auto &entry = table[(i * m_table_size) + j];
+      double res = entry.load(std::memory_order_relaxed);
+      if (std::isnan(res)) {
+        res = compute();
+        entry.store(res, std::memory_order_relaxed);
+      }
+      return res;
+    }
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    /** Number of points the tables were built for. */
+    size_t m_table_size{0};
+    /** `n × n` tables, `NaN` means "not computed yet". */
+    mutable Table m_squared_dist;
+    mutable Table m_dist;
+    mutable Table m_slope;
+  };
+
+}
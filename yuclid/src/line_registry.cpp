@@ -0,0 +1,95 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "line_registry.hpp"
+
+#include "type/point.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  void LineRegistry::add_triple(const array<Point, 3> &points) {
+    array<Point, 3> sorted = points;
+    ranges::sort(sorted);
+    m_triples.push_back(sorted);
+  }
+
+  vector<vector<Point>> LineRegistry::lines() const {
+    // Union-find over triples, two triples that share a pair of points
+    // lie on the same line.
+    vector<size_t> parent(m_triples.size());
+    iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t ind) {
+      while (parent[ind] != ind) {
+        parent[ind] = parent[parent[ind]];
+        ind = parent[ind];
+      }
+      return ind;
+    };
+    boost::unordered_flat_map<uint32_t, size_t> by_pair;
+    for (size_t ind = 0; ind < m_triples.size(); ++ ind) {
+      const auto &triple = m_triples[ind];
+      for (size_t left = 0; left < triple.size(); ++ left) {
+        for (size_t right = left + 1; right < triple.size(); ++ right) {
+          uint32_t const key = (static_cast<uint32_t>(triple[left].get()) << 16U) | triple[right].get();
+          auto [it, inserted] = by_pair.try_emplace(key, ind);
+          if (!inserted) {
+            size_t const root_old = find(it->second);
+            size_t const root_new = find(ind);
+            // Keep the smaller index as the root, so that the result is deterministic.
+            parent[max(root_old, root_new)] = min(root_old, root_new);
+          }
+        }
+      }
+    }
+
+    vector<vector<Point>> res;
+    vector<size_t> line_of_root(m_triples.size(), m_triples.size());
+    for (size_t ind = 0; ind < m_triples.size(); ++ ind) {
+      size_t const root = find(ind);
+      if (line_of_root[root] == m_triples.size()) {
+        line_of_root[root] = res.size();
+        res.emplace_back();
+      }
+      auto &line = res[line_of_root[root]];
+      line.insert(line.end(), m_triples[ind].begin(), m_triples[ind].end());
+    }
+    for (auto &line : res) {
+      ranges::sort(line);
+      auto const [first, last] = ranges::unique(line);
+      line.erase(first, last);
+    }
+    ranges::sort(res);
+    return res;
+  }
+
+  vector<array<Point, 3>> LineRegistry::spanning_triples(const vector<Point> &line) {
+    vector<array<Point, 3>> res;
+    for (size_t ind = 2; ind < line.size(); ++ ind) {
+      res.push_back({line[0], line[1], line[ind]});
+    }
+    return res;
+  }
+
+}
@@ -0,0 +1,62 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "type/point.hpp"
+
+namespace Yuclid {
+
+  /**
+   * @brief Lines through points of a problem.
+   *
+   * The theorem matcher finds collinear triples one by one.
+   * The registry merges triples that share two points into lines,
+   * so that the theorems about a line can be generated once per line.
+   *
+   * With `Config::Solver::sparse_collinear()`, only the triples
+   * through the first two points of each line get `coll`/`para` theorems.
+   * These triples are enough to put all points of the line on the same line,
+   * but the parallel chords that don't pass through the first two points
+   * aren't matched.
+   */
+  class LineRegistry final {
+  public:
+    /** @brief Record that three distinct points are collinear. */
+    void add_triple(const std::array<Point, 3> &points);
+
+    /**
+     * @brief Merge the recorded triples into lines.
+     *
+     * @return Sorted lists of points on each line,
+     * ordered by their first points.
+     */
+    [[nodiscard]] std::vector<std::vector<Point>> lines() const;
+
+    /**
+     * @brief Triples through the first two points of `line`.
+     *
+     * @param line Sorted points of a line returned by `lines()`.
+     */
+    [[nodiscard]] static std::vector<std::array<Point, 3>> spanning_triples(const std::vector<Point> &line);
+
+  private:
+    std::vector<std::array<Point, 3>> m_triples;
+  };
+
+}
@@ -15,6 +15,7 @@
 */
 #include "config_options.hpp" // Include our configuration class header
 #include "matcher.hpp"
+#include "parallel.hpp"
 #include "parser/simple.hpp"
 #include "problem.hpp"
 #include "statement/statement.hpp"
@@ -24,6 +25,9 @@
 #include "type/triangle.hpp"
 #include "solver/ddar_solver.hpp"
 #include "solver/theorem_application.hpp"
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
@@ -34,10 +38,20 @@
 #include <boost/log/utility/setup/console.hpp>
 
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
 #include <format>
+#include <functional>
 #include <iostream>     // For std::cout, std::cerr
 #include <fstream>
+#include <optional>
+#include <sstream>
 #include <stdexcept>    // For std::runtime_error
+#include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -59,9 +73,21 @@ namespace {
     logging::add_common_attributes();
   }
 
-  bool run_ddar(const Problem &prob, const Config &config) {
-    BOOST_LOG_TRIVIAL(info) << "Start initialization";
-    DDARSolver solver(&prob, &config.solver());
+  /**
+   * @brief Outcome of a run on one input, reported by `--jobs`.
+   */
+  struct RunSummary {
+    string status{"not started"};
+    size_t num_theorems{0};
+    /** Peak number of pending and established statements. */
+    size_t num_statements{0};
+    size_t num_established{0};
+  };
+
+  /**
+   * @brief Check the goals of `prob` numerically, then run DD+AR on them.
+   */
+  bool run_solver(DDARSolver &solver, const Problem &prob) {
     BOOST_LOG_TRIVIAL(info) << "Matched " << solver.num_theorems() << " theorems";
 
     for (const auto &goal : prob.goals()) {
@@ -71,46 +97,204 @@ namespace {
       }
     }
     BOOST_LOG_TRIVIAL(info) << "Running DD+AR";
-    bool const res = solver.run(500);
+    return solver.run(500);
+  }
+
+  bool run_ddar(const Problem &prob, const Config &config, ostream &out, RunSummary &summary) {
+    BOOST_LOG_TRIVIAL(info) << "Start initialization";
+    DDARSolver solver(&prob, &config.solver());
+    bool const res = run_solver(solver, prob);
     if (config.global().use_json()) {
-      solver.print_json(cout);
+      solver.print_json(out);
     } else {
-      solver.print_proof(cout);
+      solver.print_proof(out);
     }
     if (!res) {
       BOOST_LOG_TRIVIAL(info) << "Failed to solve the problem";
     }
+    summary.status = res ? "solved" : "saturated";
+    summary.num_theorems = solver.num_theorems();
+    summary.num_statements = solver.num_statements();
+    summary.num_established = solver.num_established_statements();
     return res;
   }
 
-  void match_theorems(const Problem &prob, const Config &config) {
+  void match_theorems(const Problem &prob, const Config &config, ostream &out, RunSummary &summary) {
     TheoremMatcher matcher(&prob, &config.solver());
-    BOOST_LOG_TRIVIAL(info) << std::format("Matched {} theorems", matcher.theorems().size());
-    if (config.global().use_json()) {
-      boost::json::value const jv = boost::json::value_from(matcher.theorems());
-      cout << boost::json::serialize(jv) << '\n';
-    } else {
-      for (const auto &thm : matcher.theorems()) {
-        cout << thm << '\n';
+    bool const use_json = config.global().use_json();
+    size_t num_theorems = 0;
+    // Print the theorems as they are matched;
+    // the JSON output is the same as serializing an array of all theorems.
+    if (use_json) {
+      out << '[';
+    }
+    matcher.match([&out, use_json, &num_theorems](Theorem &&thm) {
+      if (use_json) {
+        if (num_theorems > 0) {
+          out << ',';
+        }
+        out << boost::json::serialize(boost::json::value_from(thm));
+      } else {
+        out << thm << '\n';
       }
+      ++ num_theorems;
+    });
+    if (use_json) {
+      out << "]\n";
     }
+    BOOST_LOG_TRIVIAL(info) << std::format("Matched {} theorems", num_theorems);
+    summary.status = "matched";
+    summary.num_theorems = num_theorems;
   }
 
-  int run_file(const Config &config, istream &input) {
-    Problem prob = parse_input_simple(input);
+  /**
+   * @brief Answer a single `--mode serve` request.
+   *
+   * The request is a JSON object with the following fields:
+   *
+   * - `problem`: the problem in the input format of `parse_input_simple`, required;
+   * - `options`: a list of command line options used for this problem
+   *   instead of the options of the server, e.g., `["--mode", "match"]`;
+   *   `--mode serve` is rejected;
+   * - `id`: any JSON value, copied to the response.
+   *
+   * @return The JSON output of `--mode ddar --use-json` or `--mode match --use-json`.
+   */
+  boost::json::value serve_request(const boost::json::object &request, const Config &server_config) {
+    optional<Config> request_config;
+    if (const auto *options = request.if_contains("options")) {
+      vector<string> args;
+      for (const auto &arg : options->as_array()) {
+        args.emplace_back(arg.as_string());
+      }
+      request_config.emplace(args);
+      if (request_config->global().mode() == Config::Mode::SERVE) {
+        throw invalid_argument("`--mode serve` can't be used in the options of a request");
+      }
+    }
+    const Config &config = request_config ? *request_config : server_config;
+
+    istringstream input(string(request.at("problem").as_string()));
+    Problem const prob = parse_input_simple(input);
+    if (config.global().mode() == Config::Mode::MATCH) {
+      TheoremMatcher matcher(&prob, &config.solver());
+      boost::json::array res;
+      matcher.match([&res](Theorem &&thm) {
+        res.push_back(boost::json::value_from(thm));
+      });
+      return res;
+    }
+    DDARSolver solver(&prob, &config.solver());
+    std::ignore = run_solver(solver, prob);
+    return solver.to_json();
+  }
 
+  /**
+   * @brief Answer NDJSON requests from `input` until EOF.
+   *
+   * For each nonempty line of `input`, write a line
+   * `{"id": ..., "ok": true, "result": ...}` or `{"id": ..., "ok": false, "error": "..."}`
+   * to `output` and flush it.
+   * Errors in a request don't stop the server.
+   */
+  void serve(const Config &config, istream &input, ostream &output) {
+    string line;
+    while (getline(input, line)) {
+      if (ranges::all_of(line, [](unsigned char chr) { return isspace(chr) != 0; })) {
+        continue;
+      }
+      boost::json::object response;
+      try {
+        boost::json::value const request = boost::json::parse(line);
+        if (const auto *request_id = request.as_object().if_contains("id")) {
+          response["id"] = *request_id;
+        }
+        boost::json::value result = serve_request(request.as_object(), config);
+        response["ok"] = true;
+        response["result"] = std::move(result);
+      } catch (const std::exception &e) {
+        BOOST_LOG_TRIVIAL(error) << "Failed to answer a request: " << e.what();
+        response["ok"] = false;
+        response["error"] = e.what();
+      }
+      output << boost::json::serialize(response) << endl;
+    }
+  }
+
+  int run_file(const Config &config, istream &input, ostream &out, RunSummary &summary) {
     switch (config.global().mode()) {
     case Config::Mode::DDAR:
-      if (!run_ddar(prob, config) && config.global().err_on_failure()) {
+      if (!run_ddar(parse_input_simple(input), config, out, summary) &&
+          config.global().err_on_failure()) {
         return 2;
       }
       break;
     case Config::Mode::MATCH:
-      match_theorems(prob, config);
+      match_theorems(parse_input_simple(input), config, out, summary);
+      break;
+    case Config::Mode::SERVE:
+      serve(config, input, out);
     }
     return 0;
   }
 
+  /**
+   * @brief Solve all input files concurrently, `--jobs` at a time.
+   *
+   * Each file gets its own `Problem` and `DDARSolver`.
+   * Outputs are printed to stdout in the order of input files,
+   * then a summary table is printed to stderr.
+   * A file that fails doesn't stop the others.
+   *
+   * @return The first nonzero return code in the order of input files, or zero.
+   */
+  int run_batch(const Config &config) {
+    const auto &files = config.global().input_file_paths();
+    vector<ostringstream> outputs(files.size());
+    vector<RunSummary> summaries(files.size());
+    vector<double> seconds(files.size(), 0.0);
+    vector<int> codes(files.size(), 0);
+
+    vector<function<void()>> tasks;
+    tasks.reserve(files.size());
+    for (size_t i = 0; i < files.size(); ++ i) {
+      tasks.emplace_back([&, i]() {
+        BOOST_LOG_TRIVIAL(info) << "Parsing file " << files[i];
+        auto const start = chrono::steady_clock::now();
+        try {
+          ifstream input(files[i]);
+          if (!input) {
+            throw runtime_error("Failed to open " + files[i]);
+          }
+          codes[i] = run_file(config, input, outputs[i], summaries[i]);
+        } catch (const std::exception &e) {
+          BOOST_LOG_TRIVIAL(error) << files[i] << ": " << e.what();
+          summaries[i].status = string("error: ") + e.what();
+          codes[i] = 1;
+        }
+        seconds[i] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      });
+    }
+    run_tasks(tasks, config.global().num_jobs());
+
+    for (const auto &out : outputs) {
+      cout << out.str();
+    }
+    cout.flush();
+
+    cerr << std::format("{:<40} {:>8} {:>9} {:>10} {:>11}  {}\n",
+                        "file", "time, s", "theorems", "statements", "established", "status");
+    for (size_t i = 0; i < files.size(); ++ i) {
+      const auto &summary = summaries[i];
+      cerr << std::format("{:<40} {:>8.3f} {:>9} {:>10} {:>11}  {}\n",
+                          files[i], seconds[i], summary.num_theorems,
+                          summary.num_statements, summary.num_established, summary.status);
+    }
+
+    auto const failed = ranges::find_if(codes, [](int code) { return code != 0; });
+    return failed == codes.end() ? 0 : *failed;
+  }
+
 }
 
 int main(int argc, char* argv[]) {
@@ -128,18 +312,27 @@ int main(int argc, char* argv[]) {
                              << (config.solver().ar_enabled<SquaredDist>() ? "enabled" : "disabled");
     BOOST_LOG_TRIVIAL(debug) << "Equations in theorems are "
                              << (config.solver().eqn_statements_enabled() ? "enabled" : "disabled");
+    BOOST_LOG_TRIVIAL(debug) << "Sparse collinear theorems are "
+                             << (config.solver().sparse_collinear() ? "enabled" : "disabled");
+    BOOST_LOG_TRIVIAL(debug) << "Using scheduler " << config.solver().scheduler();
+    BOOST_LOG_TRIVIAL(debug) << "Using AR elimination throttle " << config.solver().elimination_throttle();
     BOOST_LOG_TRIVIAL(debug) << "Err on failure "
                              << (config.global().err_on_failure() ? "enabled" : "disabled");
+    BOOST_LOG_TRIVIAL(debug) << "Solving " << config.global().num_jobs() << " file(s) at a time";
     BOOST_LOG_TRIVIAL(info) << "Operating in mode " << config.global().mode();
 
+    RunSummary summary;
     if (config.global().input_file_paths().empty()) {
       BOOST_LOG_TRIVIAL(info) << "Parsing stdin";
-      return run_file(config, cin);
+      return run_file(config, cin, cout, summary);
+    }
+    if (config.global().num_jobs() != 1 && config.global().mode() != Config::Mode::SERVE) {
+      return run_batch(config);
     }
     for (const auto &file : config.global().input_file_paths()) {
       BOOST_LOG_TRIVIAL(info) << "Parsing file " << file;
       ifstream input(file);
-      int ret = run_file(config, input);
+      int ret = run_file(config, input, cout, summary);
       if (ret != 0) {
         return ret;
       }
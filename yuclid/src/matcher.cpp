@@ -18,9 +18,15 @@
 #include <boost/container_hash/hash.hpp>
 #include <functional>
 #include <cmath>
+#include "buckets.hpp"
+#include "circle_registry.hpp"
+#include "line_registry.hpp"
 #include "numbers/add_circle.hpp"
 #include "numbers/util.hpp"
+#include "point_grid.hpp"
 #include "problem.hpp"
+#include "shape_index.hpp"
+#include "slope_index.hpp"
 #include "statement/circumcenter.hpp"
 #include "statement/coll.hpp"
 #include "statement/angle_eq.hpp"
@@ -34,17 +40,26 @@
 #include "statement/congruent_triangles.hpp"
 #include "statement/thales.hpp"
 #include "theorem.hpp"
+#include "theorem_stream.hpp"
 #include "type/sin_or_dist.hpp"
 #include "type/squared_dist.hpp"
 #include "typedef.hpp"
+#include "verdict_cache.hpp"
 #include "config_options.hpp"
+#include "parallel.hpp"
 
 #include <algorithm>
+#include <array>
 #include <boost/log/trivial.hpp>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <format>
+#include <map>
+#include <optional>
 #include <span>
-#include <tuple>
-#include <type_traits>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <unordered_set>
@@ -55,116 +70,433 @@ using namespace std;
 namespace Yuclid {
 
   namespace {
-    template<class VectorType, class KeyFunType, class CallbackType>
-    requires
-      (is_invocable_r_v<double, KeyFunType, typename VectorType::value_type>
-      || is_invocable_r_v<double, KeyFunType, const typename VectorType::value_type&>)
-      && (is_invocable_r_v<void, CallbackType, span<typename VectorType::value_type>>
-      || is_invocable_r_v<void, CallbackType, span<const typename VectorType::value_type>>)
-    void foreach_bucket(VectorType& items,
-                        KeyFunType key_fun,
-                        const CallbackType& callback) {
-      // Determine the element type of the span based on the constness of vector_type
-      using ItemType = typename VectorType::value_type;
-      using SpanElementType =
-        conditional_t<is_const_v<remove_reference_t<VectorType>>,
-                      const ItemType,
-                      ItemType>;
-
-      if (items.empty()) {
-        return;
-      }
-      size_t start_bucket_index = 0;
-      double start_bucket_key = invoke(key_fun, items[0]);
-      double last_key = start_bucket_key;
-      for (size_t ind = 1; ind < items.size(); ++ ind) {
-        const double& key = invoke(key_fun, items[ind]);
-        // If we stay in the same bucket, test if exceeded 10x tolerance
-        // and update `last_key`
-        if (key < last_key + EPS) {
-          // If we went over 10x the tolerance by tiny steps, then issue a warning.
-          if (key >= start_bucket_key + 10 * EPS) {
-            BOOST_LOG_TRIVIAL(warning) << "While sorting " << typeid(ItemType).name()
-                                       << ": bucket tolerance 10x overflow";
+    /** @brief Concatenate vectors produced by parallel tasks. */
+    template <typename T>
+    vector<T> concat(vector<vector<T>> &&parts) {
+      size_t size = 0;
+      for (const auto &part : parts) {
+        size += part.size();
+      }
+      vector<T> res;
+      res.reserve(size);
+      for (auto &part : parts) {
+        for (auto &item : part) {
+          res.push_back(std::move(item));
+        }
+        part = vector<T>();
+      }
+      return res;
+    }
+
+    /**
+     * @brief Segments between all pairs of points, indexed by their midpoints.
+     *
+     * `ABCD` is a parallelogram iff the diagonals `AC` and `BD` share the midpoint.
+     */
+    class SegmentMidpoints {
+    public:
+      explicit SegmentMidpoints(const GeometryCache &geom) :
+        m_geometry(geom),
+        m_segments(all_segments(geom.size())),
+        m_grid(midpoints(&GeometryCache::x), midpoints(&GeometryCache::y)) {}
+
+      /**
+       * @brief Quadruples `(D, C, A, B)`, `A < C < D`,
+       * such that `ABCD` may be a parallelogram
+       * and the longer of the diagonals `AC`, `BD` ends at `right`.
+       *
+       * Besides sharing the midpoint up to the tolerance,
+       * the theorem matcher accepts `ABCD` if `AB ∥ CD` and `AD ∥ BC`
+       * up to a relative tolerance for the slopes,
+       * so we look for the midpoints in a radius proportional to the longer diagonal.
+       * The result may have false positives, which are rejected by numerical checks.
+       */
+      [[nodiscard]] vector<array<size_t, 4>> parallelograms_with(size_t right) const {
+        vector<array<size_t, 4>> res;
+        // Segments `(left, right)` are stored contiguously.
+        size_t const first = right * (right - 1) / 2;
+        for (size_t seg = first; seg < first + right; ++ seg) {
+          auto const [pt_p, pt_q] = m_segments[seg];
+          double const length = m_geometry.dist(pt_p, pt_q);
+          double const radius = (8 * REL_TOL * length) + sqrt(EPS);
+          auto const key = make_pair(length, seg);
+          for (size_t const other : m_grid.points_near(midpoint(&GeometryCache::x, seg), midpoint(&GeometryCache::y, seg), radius)) {
+            auto const [pt_r, pt_s] = m_segments[other];
+            if (pt_r == pt_p || pt_r == pt_q || pt_s == pt_p || pt_s == pt_q
+                || make_pair(m_geometry.dist(pt_r, pt_s), other) >= key) {
+              continue;
+            }
+            // Try both segments as `AC`.
+            add_quadruples(pt_p, pt_q, pt_r, pt_s, res);
+            add_quadruples(pt_r, pt_s, pt_p, pt_q, res);
+          }
+        }
+        return res;
+      }
+
+    private:
+      /** Add `(D, C, A, B)` for all choices of `D > C` on the `BD` diagonal. */
+      static void add_quadruples(size_t pt_a, size_t pt_c, size_t pt_b, size_t pt_d,
+                                 vector<array<size_t, 4>> &out) {
+        if (pt_d > pt_c) {
+          out.push_back({pt_d, pt_c, pt_a, pt_b});
+        }
+        if (pt_b > pt_c) {
+          out.push_back({pt_b, pt_c, pt_a, pt_d});
+        }
+      }
+
+      /** All pairs `(left, right)`, `left < right`, ordered by `right`, then by `left`. */
+      static vector<pair<size_t, size_t>> all_segments(size_t num_pts) {
+        vector<pair<size_t, size_t>> res;
+        res.reserve(num_pts * (num_pts - 1) / 2);
+        for (size_t right = 0; right < num_pts; ++ right) {
+          for (size_t left = 0; left < right; ++ left) {
+            res.emplace_back(left, right);
           }
-        } else {
-          // The new value does not belong to the current bucket.
-          // Act on the current bucket and start the new one.
-          callback(span<SpanElementType>(items).subspan(start_bucket_index,
-                                                        ind - start_bucket_index));
-          start_bucket_index = ind;
-          start_bucket_key = key;
         }
-        last_key = key;
-      }
-      callback(span<SpanElementType>(items).subspan(start_bucket_index));
-    }
-
-    template <typename value_type, typename callback_type>
-    requires
-      std::is_invocable_v<callback_type, const value_type&, const value_type&>
-    void foreach_pair(const vector<pair<double, value_type>> &items,
-                      callback_type callback) {
-      foreach_bucket(items, &pair<double, value_type>::first,
-                     [callback](span<const pair<double, value_type>> bucket) {
-                       size_t const size = bucket.size();
-                       for (size_t i = 0; i < size; ++ i) {
-                         for (size_t j = i + 1; j < size; ++ j) {
-                           callback(bucket[i].second, bucket[j].second);
-                         }
-                       }
-                     });
+        return res;
+      }
+
+      using Coordinate = double (GeometryCache::*)(size_t) const;
+
+      [[nodiscard]] double midpoint(Coordinate coord, size_t seg) const {
+        auto const [left, right] = m_segments[seg];
+        return ((m_geometry.*coord)(left) + (m_geometry.*coord)(right)) / 2;
+      }
+
+      [[nodiscard]] vector<double> midpoints(Coordinate coord) const {
+        vector<double> res(m_segments.size());
+        for (size_t seg = 0; seg < res.size(); ++ seg) {
+          res[seg] = midpoint(coord, seg);
+        }
+        return res;
+      }
+
+      const GeometryCache &m_geometry;
+      vector<pair<size_t, size_t>> m_segments;
+      PointGrid m_grid;
+    };
+
+    /** The part for the theorems matched by the task running on this thread. */
+    thread_local TheoremStream::Part *t_matched_theorems = nullptr;
+
+    /** Redirect `TheoremMatcher::insert_theorem` on this thread to `part`. */
+    class MatchedTheoremsSink {
+    public:
+      explicit MatchedTheoremsSink(TheoremStream::Part *part) : m_saved(t_matched_theorems) {
+        t_matched_theorems = part;
+      }
+      MatchedTheoremsSink(const MatchedTheoremsSink &) = delete;
+      MatchedTheoremsSink &operator=(const MatchedTheoremsSink &) = delete;
+      ~MatchedTheoremsSink() { t_matched_theorems = m_saved; }
+    private:
+      TheoremStream::Part *m_saved;
+    };
+
+    /** @brief Wrap `fun` into a task that writes theorems to `part` and finishes it. */
+    function<void()> task_writing_to(TheoremStream::Part &part, function<void()> fun) {
+      return [&part, fun = std::move(fun)]() {
+        {
+          MatchedTheoremsSink const sink(&part);
+          fun();
+        }
+        part.stream->finish(part);
+      };
     }
+
+    /**
+     * The families of theorems in the order they are passed to the sink.
+     *
+     * This is the order of the stages that match them,
+     * and within a stage, the order in which their tasks are started,
+     * so a group never waits for a group that is matched in a later stage.
+     */
+    enum Family : uint8_t {
+      // Stage 1
+      BETWEEN,
+      CIRCLES,
+      PERPENDICULARS,  //< With squared distance equations, see `match_perpendiculars()`
+      // Stage 2
+      TRIANGLES,
+      BETWEEN_PAIRS,
+      ANGLES,
+      PARALLELOGRAMS,
+      ORTHOCENTERS,    //< Without squared distance equations, see `all_orthocenters()`
+      SPECIAL_ANGLES,
+      // Stage 3
+      LAW_SIN,
+      LINES,
+      CYCLIC,
+      NUM_FAMILIES
+    };
   }
 
   TheoremMatcher::TheoremMatcher(const Problem *prob, const Config::Solver *config) :
-    m_problem(prob), m_config(config) {
-    match_similar_triangles();
-    match_between();
-    auto important_angles = match_equal_angles();
-    match_law_sin(important_angles);
-    match_circles();
-    match_parallelograms();
-    if (m_config->ar_enabled<SquaredDist>() && m_config->eqn_statements_enabled()) {
-      match_perpendiculars();
+    m_problem(prob), m_config(config) {}
+
+  void TheoremMatcher::match(const TheoremSink &sink) {
+    size_t const num_pts = m_problem->num_points();
+    size_t const num_threads = m_config->num_threads();
+    bool const use_squared_dist_eqns =
+      m_config->ar_enabled<SquaredDist>() && m_config->eqn_statements_enabled();
+
+    for (const auto &goal : m_problem->goals()) {
+      m_circles.add_required_points(goal->points());
+    }
+
+    TheoremStream stream(sink, m_rule_stats, NUM_FAMILIES);
+
+    // Stage 1: the outermost point loops of all families.
+    vector<vector<pair<double, Collinear>>> between_by_point(num_pts);
+    vector<vector<array<Point, 3>>> collinear_by_point(num_pts);
+    vector<vector<pair<double, Angle>>> angles_by_point(num_pts);
+    vector<vector<pair<Point, Triangle>>> orthocenters_by_point(num_pts);
+    vector<vector<array<size_t, 4>>> parallelograms_by_point(num_pts);
+    optional<SlopeIndex> slopes;
+    optional<SegmentMidpoints> segments;
+    optional<PointGrid> grid;
+    if (use_squared_dist_eqns) {
+      slopes.emplace(m_problem->geometry());
+      segments.emplace(m_problem->geometry());
     } else {
-      match_orthocenters();
+      grid.emplace(m_problem->geometry());
+    }
+    BucketStats between_stats;
+    BucketStats angle_stats;
+    BucketStats circle_stats;
+    // The tasks that write theorems are started in the order of the sink,
+    // so with one thread, only the running task buffers theorems.
+    stream.open(BETWEEN, num_pts);
+    stream.open(CIRCLES, num_pts);
+    stream.open(PERPENDICULARS, slopes ? num_pts : 0);
+    vector<function<void()>> tasks;
+    for (const Point &pt : m_problem->all_points()) {
+      size_t const ind = pt.get();
+      tasks.push_back(task_writing_to(stream.part(BETWEEN, ind),
+                                      [this, pt, ind, &between_by_point, &collinear_by_point]() {
+        between_by_point[ind] = all_between(pt, collinear_by_point[ind]);
+      }));
+    }
+    for (const Point &pt : m_problem->all_points()) {
+      tasks.push_back(task_writing_to(stream.part(CIRCLES, pt.get()), [this, pt, &circle_stats]() {
+        match_circles(pt, circle_stats);
+      }));
     }
+    for (const Point &pt : m_problem->all_points()) {
+      size_t const ind = pt.get();
+      if (slopes) {
+        tasks.push_back(task_writing_to(stream.part(PERPENDICULARS, ind), [this, pt, &slopes]() {
+          match_perpendiculars(pt, *slopes);
+        }));
+      } else {
+        tasks.emplace_back([this, pt, ind, &grid, &orthocenters_by_point]() {
+          orthocenters_by_point[ind] = all_orthocenters(pt, *grid);
+        });
+      }
+      tasks.emplace_back([this, pt, ind, &angles_by_point]() {
+        angles_by_point[ind] = all_angles(pt);
+      });
+      if (segments) {
+        tasks.emplace_back([ind, &segments, &parallelograms_by_point]() {
+          parallelograms_by_point[ind] = segments->parallelograms_with(ind);
+        });
+      }
+    }
+    run_tasks(tasks, num_threads);
+    tasks.clear();
+
+    // Similar triangles are found in one streaming pass over the points:
+    // the triangles of a slice of points are generated in parallel,
+    // then each triangle is looked up among the triangles inserted before it and inserted.
+    // Only the index and the triangles of one slice are held at a time,
+    // and the pairs don't depend on the size of the slice.
+    ShapeIndex shapes;
+    vector<vector<pair<size_t, size_t>>> similar_by_point(num_pts);
+    size_t const slice_size = num_threads == 0 ? max(thread::hardware_concurrency(), 1U) : num_threads;
+    vector<vector<Triangle>> slice(slice_size);
+    for (size_t first = 0; first < num_pts; first += slice_size) {
+      size_t const last = min(num_pts, first + slice_size);
+      for (size_t ind = first; ind < last; ++ ind) {
+        tasks.emplace_back([this, ind, first, &slice]() {
+          slice[ind - first] = all_triangles(Point(ind, m_problem->id()));
+        });
+      }
+      run_tasks(tasks, num_threads);
+      tasks.clear();
+      for (size_t ind = first; ind < last; ++ ind) {
+        for (const Triangle &tri : slice[ind - first]) {
+          size_t const right = shapes.insert(tri);
+          for (size_t const left : shapes.same_shape_before(right)) {
+            similar_by_point[ind].emplace_back(left, right);
+          }
+        }
+        slice[ind - first] = {};
+      }
+    }
+
+    // Stage 2: sort the candidates and process buckets of similar items.
+    // The concatenated vectors are the same as if we generated them in one loop,
+    // so the buckets don't depend on the number of threads.
+    stream.open(TRIANGLES, num_pts);
+    for (size_t i = 0; i < num_pts; ++ i) {
+      tasks.push_back(task_writing_to(stream.part(TRIANGLES, i), [this, &shapes, &pairs = similar_by_point[i]]() {
+        match_similar_triangles(shapes, pairs);
+      }));
+    }
+
+    auto between = concat(std::move(between_by_point));
+    ranges::sort(between, {}, &pair<double, Collinear>::first);
+    auto between_buckets = all_buckets(as_const(between), &pair<double, Collinear>::first, &between_stats);
+    stream.open(BETWEEN_PAIRS, between_buckets.size());
+    for (size_t i = 0; i < between_buckets.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(BETWEEN_PAIRS, i), [this, bucket = between_buckets[i]]() {
+        match_between(bucket);
+      }));
+    }
+
+    auto angles = concat(std::move(angles_by_point));
+    ranges::sort(angles, {}, &pair<double, Angle>::first);
+    auto angle_buckets = all_buckets(as_const(angles), &pair<double, Angle>::first, &angle_stats);
+    stream.open(ANGLES, angle_buckets.size());
+    vector<unordered_set<SinOrDist, boost::hash<SinOrDist>>> important_by_bucket(angle_buckets.size());
+    vector<vector<array<Point, 4>>> cyclic_by_bucket(angle_buckets.size());
+    for (size_t i = 0; i < angle_buckets.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(ANGLES, i),
+                                      [this, i, &angle_buckets, &important_by_bucket, &cyclic_by_bucket]() {
+        match_equal_angles(angle_buckets[i], important_by_bucket[i], cyclic_by_bucket[i]);
+      }));
+    }
+
+    // Match the parallelograms in the order of `(D, C, A, B)`, one part per `D`.
+    auto parallelograms = concat(std::move(parallelograms_by_point));
+    ranges::sort(parallelograms);
+    vector<span<const array<size_t, 4>>> parallelogram_groups;
+    for (auto first = parallelograms.begin(); first != parallelograms.end(); ) {
+      size_t const ind_d = (*first)[0];
+      auto const last = find_if(first, parallelograms.end(), [ind_d](const auto &item) {
+        return item[0] != ind_d;
+      });
+      parallelogram_groups.emplace_back(first, last);
+      first = last;
+    }
+    stream.open(PARALLELOGRAMS, parallelogram_groups.size());
+    for (size_t i = 0; i < parallelogram_groups.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(PARALLELOGRAMS, i), [this, group = parallelogram_groups[i]]() {
+        match_parallelograms(group);
+      }));
+    }
+
+    // Group the orthocenters by the orthocenter,
+    // keeping the order of the triangles within each group.
+    auto orthocenters = concat(std::move(orthocenters_by_point));
+    ranges::stable_sort(orthocenters, {}, &pair<Point, Triangle>::first);
+    vector<span<const pair<Point, Triangle>>> orthocenter_groups;
+    for (auto first = orthocenters.begin(); first != orthocenters.end(); ) {
+      auto const last = find_if(first, orthocenters.end(), [first](const auto &item) {
+        return item.first != first->first;
+      });
+      orthocenter_groups.emplace_back(first, last);
+      first = last;
+    }
+    stream.open(ORTHOCENTERS, orthocenter_groups.size());
+    for (size_t i = 0; i < orthocenter_groups.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(ORTHOCENTERS, i), [this, group = orthocenter_groups[i]]() {
+        for (const auto &[pt_d, tri] : group) {
+          on_orthocenter({tri, pt_d});
+        }
+      }));
+    }
+    run_tasks(tasks, num_threads);
+    tasks.clear();
+
+    stream.open(SPECIAL_ANGLES, 1);
+    task_writing_to(stream.part(SPECIAL_ANGLES, 0), [this, &angles]() {
+      match_special_angles(angles);
+    })();
+
+    // Stage 3: laws of sines, which need the angles that are equal to other angles,
+    // and circles through the cyclic quadrangles found in stage 2.
+    unordered_set<SinOrDist, boost::hash<SinOrDist>> important_angles;
+    for (const auto &part : important_by_bucket) {
+      important_angles.insert(part.begin(), part.end());
+    }
+    stream.open(LAW_SIN, num_pts);
+    for (const Point &pt : m_problem->all_points()) {
+      tasks.push_back(task_writing_to(stream.part(LAW_SIN, pt.get()), [this, pt, &important_angles]() {
+        match_law_sin(important_angles, pt);
+      }));
+    }
+    for (const auto &part : cyclic_by_bucket) {
+      for (const auto &quad : part) {
+        m_circles.add_quadrangle(quad);
+      }
+    }
+    LineRegistry line_registry;
+    for (const auto &part : collinear_by_point) {
+      for (const auto &triple : part) {
+        line_registry.add_triple(triple);
+      }
+    }
+    auto const lines = line_registry.lines();
+    stream.open(LINES, lines.size());
+    for (size_t i = 0; i < lines.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(LINES, i), [this, &line = lines[i]]() {
+        match_line(line);
+      }));
+    }
+    auto const circles = m_circles.circles();
+    stream.open(CYCLIC, circles.size());
+    for (size_t i = 0; i < circles.size(); ++ i) {
+      tasks.push_back(task_writing_to(stream.part(CYCLIC, i), [this, &circle = circles[i]]() {
+        match_cyclic(circle);
+      }));
+    }
+    run_tasks(tasks, num_threads);
+    tasks.clear();
+
+    assert(stream.done());
+    for (const auto &[name, stats] : m_rule_stats) {
+      if (stats.duplicates > 0) {
+        BOOST_LOG_TRIVIAL(debug) << format("Rule {}: {} matches, {} of them duplicates, {} theorems",
+                                           name, stats.candidates, stats.duplicates, stats.matched);
+      }
+    }
+    BOOST_LOG_TRIVIAL(debug) << "Numeric verdicts of statements: " << m_verdicts.to_string();
+    BOOST_LOG_TRIVIAL(debug) << "Buckets of equal ratios: " << between_stats.to_string();
+    BOOST_LOG_TRIVIAL(debug) << "Buckets of equal angles: " << angle_stats.to_string();
+    BOOST_LOG_TRIVIAL(debug) << "Buckets of equal distances: " << circle_stats.to_string();
   }
 
-  vector<tuple<double, double, Triangle>> TheoremMatcher::all_triangles() {
-    vector<tuple<double, double, Triangle>> res;
+  vector<Triangle> TheoremMatcher::all_triangles(const Point &pt_a) {
+    vector<Triangle> res;
     const size_t num_pts = m_problem->num_points();
     // If there are no isosceles triangles,
-    // then the right estimate is `n * (n - 1) * (n - 2) / 6`.
+    // then the right estimate is `(n - 1) * (n - 2) / 6` per vertex `A`.
     // We use a slightly larger number
     // to leave room for copies of isosceles triangles.
-    res.reserve(num_pts * num_pts * num_pts / 6);
-    for (const auto &pt_a : m_problem->all_points()) {
-      for (const auto &pt_b : m_problem->all_points()) {
-        if (pt_a.is_close(pt_b)) {
+    res.reserve(num_pts * num_pts / 6);
+    for (const auto &pt_b : m_problem->all_points()) {
+      if (pt_a.is_close(pt_b)) {
+        continue;
+      }
+      for (const auto &pt_c : m_problem->all_points()) {
+        if (Collinear(pt_a, pt_b, pt_c).check_equations()) {
           continue;
         }
-        for (const auto &pt_c : m_problem->all_points()) {
-          if (Collinear(pt_a, pt_b, pt_c).check_equations()) {
-            continue;
-          }
-          // In order to deduplicate triangles,
-          // we only select those with `|AB| <= |BC| <= |AC|`,
-          // leaving a room for error.
-          double const dist_ab(Dist(pt_a, pt_b));
-          double const dist_ac(Dist(pt_a, pt_c));
-          double const dist_bc(Dist(pt_b, pt_c));
-          if (dist_ab > (1 + REL_TOL) * dist_bc) {
-            continue;
-          }
-          if (dist_bc > (1 + REL_TOL) * dist_ac) {
-            continue;
-          }
-          res.emplace_back(dist_ab / dist_ac,
-                           dist_ab / dist_bc,
-                           Triangle(pt_a, pt_b, pt_c));
+        // In order to deduplicate triangles,
+        // we only select those with `|AB| <= |BC| <= |AC|`,
+        // leaving a room for error.
+        double const dist_ab(Dist(pt_a, pt_b));
+        double const dist_ac(Dist(pt_a, pt_c));
+        double const dist_bc(Dist(pt_b, pt_c));
+        if (dist_ab > (1 + REL_TOL) * dist_bc) {
+          continue;
+        }
+        if (dist_bc > (1 + REL_TOL) * dist_ac) {
+          continue;
         }
+        res.emplace_back(pt_a, pt_b, pt_c);
       }
     }
     return res;
@@ -186,79 +518,57 @@ namespace Yuclid {
     insert_theorem(Theorem::similar_triangles_of_sss(simtri));
   }
 
-  void TheoremMatcher::on_span_triangles(span<const tuple<double, double, Triangle>> bucket) {
-    size_t const bucket_size = bucket.size();
-    for (size_t left = 0; left < bucket_size; ++ left) {
-      double const area_left = get<2>(bucket[left]).area();
-      for (size_t right = left + 1; right < bucket_size; ++ right) {
-        bool const same_clockwise = (area_left > 0) == (get<2>(bucket[right]).area() > 0);
-        on_similar_triangles({
-            get<2>(bucket[left]),
-            get<2>(bucket[right]),
-            same_clockwise
-          });
-      }
+  void TheoremMatcher::match_similar_triangles(const ShapeIndex &shapes,
+                                               span<const pair<size_t, size_t>> pairs) {
+    for (auto const [left, right] : pairs) {
+      bool const same_clockwise = (shapes[left].area() > 0) == (shapes[right].area() > 0);
+      on_similar_triangles({shapes[left], shapes[right], same_clockwise});
     }
   }
 
-  void TheoremMatcher::match_similar_triangles() {
-    using item_type = tuple<double, double, Triangle>;
-    auto triangles = all_triangles();
-    // Sort by `|AB|:|AC|`.
-    ranges::sort(triangles, {}, [](const auto& item) {
-      return std::get<0>(item);
-    });
-  
-  
-    foreach_bucket(triangles,
-                   [](const auto& item) { return std::get<0>(item); },
-                   [this](span<item_type> outer_bucket) {
-                     ranges::sort(outer_bucket, {}, [](const auto& item) {
-                       return std::get<1>(item);
-                     });
-                     foreach_bucket(outer_bucket, [](const auto& item) {
-                       return std::get<1>(item);
-                     }, [this](span<const item_type> bucket) {
-                       on_span_triangles(bucket);
-                     });
-                   });
-  }
-
   void TheoremMatcher::insert_theorem(const Theorem &thm) {
-    if (!thm.check_numerically()) {
+    assert(t_matched_theorems != nullptr);
+    TheoremStream::Part &part = *t_matched_theorems;
+    RuleStats &stats = part.rule_stats[thm.name()];
+    ++ stats.candidates;
+    // Theorems with the same normalized form may have different nondegeneracy conditions,
+    // so each copy is checked, and only the numerically true ones are deduplicated.
+    if (!thm.check_numerically(m_verdicts)) {
       return;
     }
-    m_theorems.push_back(thm.normalize());
+    if (!part.stream->insert(part, thm.normalize())) {
+      ++ stats.duplicates;
+    }
   }
 
-  vector<pair<double, Collinear>> TheoremMatcher::sorted_between() {
-    vector<pair<double, Collinear>> all_between;
-    for (auto right : m_problem->all_points()) {
-      for (auto middle : m_problem->all_points()) {
-        for (auto left : right.up_to()) {
-          Collinear const pred(left, middle, right);
-          if (!pred.check_numerically() || !pred.is_between()) {
-            continue;
-          }
-          on_between({left, middle, right});
-          double const dist_left(Dist(left, middle));
-          double const dist_right(Dist(middle, right));
-          if (dist_left <= (1 + REL_TOL) * dist_right) {
-            all_between.emplace_back(dist_left / (dist_left + dist_right),
-                                     pred);
-            if (dist_right <= (1 + REL_TOL) * dist_left) {
-              on_midpoint({left, middle, right});
-            }
-          }
+  vector<pair<double, Collinear>> TheoremMatcher::all_between(const Point &right,
+                                                               vector<array<Point, 3>> &collinear) {
+    vector<pair<double, Collinear>> res;
+    for (auto middle : m_problem->all_points()) {
+      for (auto left : right.up_to()) {
+        Collinear const pred(left, middle, right);
+        if (!pred.check_numerically() || !pred.is_between()) {
+          continue;
+        }
+        on_between({left, middle, right});
+        if (m_config->sparse_collinear()) {
+          collinear.push_back({left, middle, right});
+        }
+        double const dist_left(Dist(left, middle));
+        double const dist_right(Dist(middle, right));
+        if (dist_left <= (1 + REL_TOL) * dist_right) {
+          res.emplace_back(dist_left / (dist_left + dist_right), pred);
           if (dist_right <= (1 + REL_TOL) * dist_left) {
-            all_between.emplace_back(dist_right / (dist_right + dist_left),
-                                     Collinear(right, middle, left));
+            on_midpoint({left, middle, right});
           }
         }
+        if (dist_right <= (1 + REL_TOL) * dist_left) {
+          res.emplace_back(dist_right / (dist_right + dist_left),
+                           Collinear(right, middle, left));
+        }
       }
     }
-    ranges::sort(all_between, {}, &pair<double, Collinear>::first);
-    return all_between;
+    return res;
   }
 
   void TheoremMatcher::on_between(const Collinear& pred) {
@@ -266,12 +576,24 @@ namespace Yuclid {
       insert_theorem(Theorem::coll_of_add_length(pred));
       insert_theorem(Theorem::add_length_of_between(pred));
     }
+    if (!m_config->sparse_collinear()) {
+      on_collinear(pred);
+    }
+  }
+
+  void TheoremMatcher::on_collinear(const Collinear &pred) {
     for (const auto &perm : pred.cyclic_permutations()) {
       insert_theorem(Theorem::coll_of_para(perm));
       insert_theorem(Theorem::para_of_coll(perm));
     }
   }
 
+  void TheoremMatcher::match_line(const vector<Point> &line) {
+    for (const auto &[pt_a, pt_b, pt_c] : LineRegistry::spanning_triples(line)) {
+      on_collinear({pt_a, pt_b, pt_c});
+    }
+  }
+
   void TheoremMatcher::on_midpoint(const Midpoint& pred) {
     if (m_config->ar_enabled<SquaredDist>() && m_config->eqn_statements_enabled()) {
       for (const auto &other : m_problem->all_points()) {
@@ -300,11 +622,13 @@ namespace Yuclid {
     insert_theorem(Theorem::cong_of_midpoint(pred));
   }
 
-  void TheoremMatcher::match_between() {
-    const vector<pair<double, Collinear>> all = sorted_between();
-    foreach_pair(all, [this](const Collinear& left, const Collinear& right) {
-      on_between_equal_ratio(left, right);
-    });
+  void TheoremMatcher::match_between(span<const pair<double, Collinear>> bucket) {
+    size_t const size = bucket.size();
+    for (size_t i = 0; i < size; ++ i) {
+      for (size_t j = i + 1; j < size; ++ j) {
+        on_between_equal_ratio(bucket[i].second, bucket[j].second);
+      }
+    }
   }
 
   void TheoremMatcher::on_between_equal_ratio(const Collinear &left,
@@ -329,43 +653,37 @@ namespace Yuclid {
     insert_theorem(Theorem::thales_eqratio_of_para(thales));
   }
 
-  vector<pair<double, Angle>> TheoremMatcher::all_angles() {
-    // Create buckets of approximately equal angles.
+  vector<pair<double, Angle>> TheoremMatcher::all_angles(const Point &left) {
     size_t const num_pts = m_problem->num_points();
     vector<pair<double, Angle>> all;
-    all.reserve(num_pts * (num_pts - 1) * (num_pts - 2));
-    for (const Point &left : m_problem->all_points()) {
-      for (const Point &vertex : m_problem->all_points()) {
-        for (const Point &right : m_problem->all_points()) {
-          if (!Collinear(left, vertex, right).check_equations()) {
-            Angle ang {left, vertex, right};
-            all.emplace_back(AddCircle<double>(ang).number(), ang);
-          }
+    all.reserve((num_pts - 1) * (num_pts - 2));
+    for (const Point &vertex : m_problem->all_points()) {
+      for (const Point &right : m_problem->all_points()) {
+        if (!Collinear(left, vertex, right).check_equations()) {
+          Angle ang {left, vertex, right};
+          all.emplace_back(AddCircle<double>(ang).number(), ang);
         }
       }
     }
-    ranges::sort(all, {}, &pair<double, Angle>::first);
     return all;
   }
 
-  unordered_set<SinOrDist, boost::hash<SinOrDist>> TheoremMatcher::match_equal_angles() {
-    const vector<pair<double, Angle>> all = all_angles();
-    unordered_set<SinOrDist, boost::hash<SinOrDist>> important_angles;
-
+  void TheoremMatcher::match_equal_angles
+  (span<const pair<double, Angle>> bucket,
+   unordered_set<SinOrDist, boost::hash<SinOrDist>> &important_angles,
+   vector<array<Point, 4>> &cyclic) {
     // Process pairs of equal angles
     // and note the angles that are equal to other angles.
-    auto const process_bucket =
-      [this, &important_angles](span<const pair<double, Angle>> bucket) {
-        size_t const size = bucket.size();
-        for (size_t left = 0; left < size; ++ left) {
-          important_angles.insert(SinOrDist(bucket[left].second));
-          for (size_t right = left + 1; right < size; ++ right) {
-            on_equal_angles(bucket[left].second, bucket[right].second);
-          }
-        }
-      };
+    size_t const size = bucket.size();
+    for (size_t left = 0; left < size; ++ left) {
+      important_angles.insert(SinOrDist(bucket[left].second));
+      for (size_t right = left + 1; right < size; ++ right) {
+        on_equal_angles(bucket[left].second, bucket[right].second, cyclic);
+      }
+    }
+  }
 
-    foreach_bucket(all, &pair<double, Angle>::first, process_bucket);
+  void TheoremMatcher::match_special_angles(const vector<pair<double, Angle>> &all) {
     if (m_config->ar_enabled<SquaredDist>() && m_config->eqn_statements_enabled()) {
       for (const auto &item :
              ranges::equal_range(all,
@@ -391,22 +709,23 @@ namespace Yuclid {
         }
       }
     }
-
-    return important_angles;
   }
 
-  void TheoremMatcher::on_equal_angles(const Angle& left, const Angle& right) {
+  void TheoremMatcher::on_equal_angles(const Angle& left, const Angle& right,
+                                       vector<array<Point, 4>> &cyclic) {
     // If the equality has a form `∠ ABD = ∠ ACD`,
     // then it's a cyclic quadrilateral `ABCD`.
     // In order to avoid duplicate matches,
     // we only match if `B, C < A < D`.
     // This way we match each quadrilateral once.
+    // The theorems are generated per circle, see `match_cyclic`.
     if (left.left() == right.left()
         && left.right() == right.right()
         && left.left() < left.right()
         && left.vertex() < left.left()
-        && right.vertex() < right.left()) {
-      on_cyclic({left.vertex(), right.vertex(), left.left(), left.right()});
+        && right.vertex() < right.left()
+        && CyclicQuadrangle(left.vertex(), right.vertex(), left.left(), left.right()).check_numerically()) {
+      cyclic.push_back({left.vertex(), right.vertex(), left.left(), left.right()});
     }
 
     // Process `∠ ABC = ∠ CBD`, `A ≠ D`.
@@ -447,6 +766,22 @@ namespace Yuclid {
     } // if ar_sin_enabled
   }
 
+  void TheoremMatcher::match_cyclic(const vector<Point> &circle) {
+    size_t const size = circle.size();
+    for (size_t pt_a = 0; pt_a < size; ++ pt_a) {
+      for (size_t pt_b = pt_a + 1; pt_b < size; ++ pt_b) {
+        for (size_t pt_c = pt_b + 1; pt_c < size; ++ pt_c) {
+          for (size_t pt_d = pt_c + 1; pt_d < size; ++ pt_d) {
+            array const quad{circle[pt_a], circle[pt_b], circle[pt_c], circle[pt_d]};
+            if (m_circles.uses_quadrangle(pt_a, pt_b, size, quad)) {
+              on_cyclic({quad[0], quad[1], quad[2], quad[3]});
+            }
+          }
+        }
+      }
+    }
+  }
+
   void TheoremMatcher::on_cyclic(const CyclicQuadrangle& pred) {
     insert_theorem(Theorem::cyclic_of_equal_angles(pred));
     insert_theorem(Theorem::cyclic_of_equal_angles({pred.a(), pred.c(), pred.b(), pred.d()}));
@@ -485,22 +820,20 @@ namespace Yuclid {
     insert_theorem(Theorem::incenter(point, angle));
   }
 
-  void TheoremMatcher::match_circles() {
+  void TheoremMatcher::match_circles(const Point &center, BucketStats &stats) {
     const size_t num_pts = m_problem->num_points();
-    for (const Point &center : m_problem->all_points()) {
-      vector<pair<double, Point>> pts;
-      pts.reserve(num_pts - 1);
-      for (const Point &other : m_problem->all_points()) {
-        if (!center.is_close(other)) {
-          pts.emplace_back(double(Dist(center, other)), other);
-        }
+    vector<pair<double, Point>> pts;
+    pts.reserve(num_pts - 1);
+    for (const Point &other : m_problem->all_points()) {
+      if (!center.is_close(other)) {
+        pts.emplace_back(double(Dist(center, other)), other);
       }
-      ranges::sort(pts, {}, &pair<double, Point>::first);
-      foreach_bucket(pts, &pair<double, Point>::first,
-                     [&center, this](span<const pair<double, Point>> bucket) {
-                       on_circle(center, bucket);
-                     });
     }
+    ranges::sort(pts, {}, &pair<double, Point>::first);
+    foreach_bucket(pts, &pair<double, Point>::first,
+                   [&center, this](span<const pair<double, Point>> bucket) {
+                     on_circle(center, bucket);
+                   }, &stats);
   }
 
   void TheoremMatcher::on_circle(const Point &center, span<const pair<double, Point>> points) {
@@ -509,13 +842,20 @@ namespace Yuclid {
       for (size_t pt_b = pt_a + 1; pt_b < size; ++ pt_b) {
         on_isosceles_triangle(center, points[pt_a].second, points[pt_b].second);
         for (size_t pt_c = pt_b + 1; pt_c < size; ++ pt_c) {
-          on_circumcenter({
-              center, {points[pt_a].second, points[pt_b].second, points[pt_c].second}
-            });
+          if (m_circles.uses_triangle(pt_a, size,
+                                      {points[pt_a].second, points[pt_b].second, points[pt_c].second})) {
+            on_circumcenter({
+                center, {points[pt_a].second, points[pt_b].second, points[pt_c].second}
+              });
+          }
           for (size_t pt_d = pt_c + 1; pt_d < size; ++ pt_d) {
-            on_quadrangle_circumcenter(center,
-                                       { points[pt_a].second, points[pt_b].second,
-                                         points[pt_c].second, points[pt_d].second });
+            if (m_circles.uses_quadrangle(pt_a, pt_b, size,
+                                          {points[pt_a].second, points[pt_b].second,
+                                           points[pt_c].second, points[pt_d].second})) {
+              on_quadrangle_circumcenter(center,
+                                         { points[pt_a].second, points[pt_b].second,
+                                           points[pt_c].second, points[pt_d].second });
+            }
           }
         }
       }
@@ -567,79 +907,113 @@ namespace Yuclid {
   }
 
 
-  void TheoremMatcher::match_parallelograms() {
-    if (m_config->ar_enabled<SquaredDist>() && m_config->eqn_statements_enabled()) {
-      for (const auto &pt_d : m_problem->all_points()) {
-        for (const auto &pt_c : pt_d.up_to()) {
-          for (const auto &pt_a : pt_c.up_to()) {
-            for (const auto &pt_b : m_problem->all_points()) {
-              if (pt_a == pt_b || pt_b == pt_c || pt_b == pt_d) {
-                continue;
-              }
-              Parallelogram const pred(pt_a, pt_b, pt_c, pt_d);
-              insert_theorem(Theorem::parallelogram_law(pred));
-            }
-          }
-        }
-      }
+  void TheoremMatcher::match_parallelograms(span<const array<size_t, 4>> candidates) {
+    ProblemRegistry::Id const owner = m_problem->id();
+    for (const auto &[ind_d, ind_c, ind_a, ind_b] : candidates) {
+      Parallelogram const pred(Point(ind_a, owner), Point(ind_b, owner),
+                               Point(ind_c, owner), Point(ind_d, owner));
+      insert_theorem(Theorem::parallelogram_law(pred));
     }
   }
 
-  void TheoremMatcher::match_perpendiculars() {
-    for (const auto &pt_b : m_problem->all_points()) {
-      for (const auto &pt_a : pt_b.up_to()) {
-        for (const auto &pt_d : pt_b.up_to()) {
-          for (const auto &pt_c : pt_d.up_to()) {
-            if (pt_a == pt_c || pt_a == pt_d) {
-              continue;
-            }
-            Perpendicular const pred(SlopeAngle(pt_a, pt_b), SlopeAngle(pt_c, pt_d));
-            if (pred.check_equations()) {
-              insert_theorem(Theorem::perp_of_sum_squares(pred));
-              insert_theorem(Theorem::sum_squares_of_perp(pred));
-            }
-          }
+  void TheoremMatcher::match_perpendiculars(const Point &pt_b, const SlopeIndex &slopes) {
+    ProblemRegistry::Id const owner = m_problem->id();
+    size_t const ind_b = pt_b.get();
+    // Pairs `(D, C)` perpendicular to `AB`, sorted to keep the order of the theorems stable.
+    vector<pair<size_t, size_t>> found;
+    for (const auto &pt_a : pt_b.up_to()) {
+      size_t const ind_a = pt_a.get();
+      found.clear();
+      for (const auto &[ind_c, ind_d] : slopes.perpendicular_candidates(ind_a, ind_b)) {
+        if (ind_d >= ind_b || ind_a == ind_c || ind_a == ind_d) {
+          continue;
+        }
+        Perpendicular const pred(SlopeAngle(pt_a, pt_b),
+                                 SlopeAngle(Point(ind_c, owner), Point(ind_d, owner)));
+        if (pred.check_equations()) {
+          found.emplace_back(ind_d, ind_c);
         }
       }
+      ranges::sort(found);
+      for (const auto &[ind_d, ind_c] : found) {
+        Perpendicular const pred(SlopeAngle(pt_a, pt_b),
+                                 SlopeAngle(Point(ind_c, owner), Point(ind_d, owner)));
+        insert_theorem(Theorem::perp_of_sum_squares(pred));
+        insert_theorem(Theorem::sum_squares_of_perp(pred));
+      }
     }
   }
 
-  void TheoremMatcher::match_orthocenters() {
-    for (const auto &pt_d : m_problem->all_points()) {
-      for (const auto &pt_c : pt_d.up_to()) {
-        for (const auto &pt_b : pt_c.up_to()) {
-          for (const auto &pt_a : pt_b.up_to()) {
-            IsOrthocenter const pred(Triangle{pt_a, pt_b, pt_c}, pt_d);
-            if (pred.check_numerically()) {
-              insert_theorem(Theorem::orthocenter(pred));
-              insert_theorem(Theorem::orthocenter({Triangle{pt_b, pt_c, pt_a}, pt_d}));
-              insert_theorem(Theorem::orthocenter({Triangle{pt_c, pt_a, pt_b}, pt_d}));
-            }
+  vector<pair<Point, Triangle>> TheoremMatcher::all_orthocenters(const Point &pt_c, const PointGrid &grid) {
+    vector<pair<Point, Triangle>> res;
+    const GeometryCache &geom = m_problem->geometry();
+    size_t const ind_c = pt_c.get();
+    for (const auto &pt_b : pt_c.up_to()) {
+      for (const auto &pt_a : pt_b.up_to()) {
+        size_t const ind_b = pt_b.get();
+        size_t const ind_a = pt_a.get();
+        // The orthocenter `H` satisfies `(H - A) ⋅ u = 0`, `(H - B) ⋅ v = 0`.
+        double const u_x = geom.x(ind_c) - geom.x(ind_b);
+        double const u_y = geom.y(ind_c) - geom.y(ind_b);
+        double const v_x = geom.x(ind_c) - geom.x(ind_a);
+        double const v_y = geom.y(ind_c) - geom.y(ind_a);
+        double const det = (u_x * v_y) - (u_y * v_x);
+        double const len_u = hypot(u_x, u_y);
+        double const len_v = hypot(v_x, v_y);
+        if (det == 0 || len_u == 0 || len_v == 0) {
+          continue;
+        }
+        double const dot_a = (u_x * geom.x(ind_a)) + (u_y * geom.y(ind_a));
+        double const dot_b = (v_x * geom.x(ind_b)) + (v_y * geom.y(ind_b));
+        double const h_x = ((dot_a * v_y) - (u_y * dot_b)) / det;
+        double const h_y = ((u_x * dot_b) - (v_x * dot_a)) / det;
+        // `IsOrthocenter::check_equations` allows `D` to be off each altitude
+        // by about `REL_TOL |DA|` (resp. `REL_TOL |DB|`) or `EPS / |u|` (resp. `EPS / |v|`).
+        // The altitudes meet at the angle `C`, so `D` is off `H` by at most this radius,
+        // up to a safety factor.
+        double const sin_c = abs(det) / (len_u * len_v);
+        double const width =
+          (2 * REL_TOL * (hypot(h_x - geom.x(ind_a), h_y - geom.y(ind_a))
+                          + hypot(h_x - geom.x(ind_b), h_y - geom.y(ind_b))))
+          + (2 * EPS / len_u) + (2 * EPS / len_v);
+        for (size_t const ind_d : grid.points_near(h_x, h_y, 2 * width / sin_c)) {
+          if (ind_d <= ind_c) {
+            continue;
+          }
+          Point const pt_d(ind_d, m_problem->id());
+          if (IsOrthocenter(Triangle{pt_a, pt_b, pt_c}, pt_d).check_numerically()) {
+            res.emplace_back(pt_d, Triangle{pt_a, pt_b, pt_c});
           }
         }
       }
     }
+    return res;
   }
 
-  void TheoremMatcher::match_law_sin(const unordered_set<SinOrDist, boost::hash<SinOrDist>> &angles) {
+  void TheoremMatcher::on_orthocenter(const IsOrthocenter &pred) {
+    insert_theorem(Theorem::orthocenter(pred));
+    insert_theorem(Theorem::orthocenter({Triangle{pred.b(), pred.c(), pred.a()}, pred.orthocenter()}));
+    insert_theorem(Theorem::orthocenter({Triangle{pred.c(), pred.a(), pred.b()}, pred.orthocenter()}));
+  }
+
+  void TheoremMatcher::match_law_sin(const unordered_set<SinOrDist, boost::hash<SinOrDist>> &angles,
+                                     const Point &pt_c) {
     if (m_config->ar_sin_enabled() && m_config->eqn_statements_enabled()) {
-      for (const Point &pt_c : m_problem->all_points()) {
-        for (const Point &pt_b : pt_c.up_to()) {
-          for (const Point &pt_a : pt_b.up_to()) {
-            if (!Collinear(pt_a, pt_b, pt_c).check_equations()) {
-              Triangle tri {pt_a, pt_b, pt_c};
-              bool const sin_a = angles.contains(SinOrDist(tri.angle_a()));
-              bool const sin_b = angles.contains(SinOrDist(tri.angle_b()));
-              bool const sin_c = angles.contains(SinOrDist(tri.angle_c()));
-              if (sin_a && sin_b) {
-                insert_theorem(Theorem::law_of_sines(tri));
-              }
-              if (sin_b && sin_c) {
-                insert_theorem(Theorem::law_of_sines({tri.b(), tri.c(), tri.a()}));
-              }
-              if (sin_a && !sin_b && sin_c) {
-                insert_theorem(Theorem::law_of_sines({tri.c(), tri.a(), tri.b()}));
-              }
+      for (const Point &pt_b : pt_c.up_to()) {
+        for (const Point &pt_a : pt_b.up_to()) {
+          if (!Collinear(pt_a, pt_b, pt_c).check_equations()) {
+            Triangle tri {pt_a, pt_b, pt_c};
+            bool const sin_a = angles.contains(SinOrDist(tri.angle_a()));
+            bool const sin_b = angles.contains(SinOrDist(tri.angle_b()));
+            bool const sin_c = angles.contains(SinOrDist(tri.angle_c()));
+            if (sin_a && sin_b) {
+              insert_theorem(Theorem::law_of_sines(tri));
+            }
+            if (sin_b && sin_c) {
+              insert_theorem(Theorem::law_of_sines({tri.b(), tri.c(), tri.a()}));
+            }
+            if (sin_a && !sin_b && sin_c) {
+              insert_theorem(Theorem::law_of_sines({tri.c(), tri.a(), tri.b()}));
             }
           }
         }
@@ -14,60 +14,120 @@
    limitations under the License.
 */
 #pragma once
+#include <array>
 #include <boost/container_hash/hash.hpp>
+#include <cstddef>
+#include <functional>
+#include <map>
 #include <vector>
 #include <span>
-#include <tuple>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
 
+#include "circle_registry.hpp"
 #include "config_options.hpp"
+#include "theorem_stream.hpp"
+#include "verdict_cache.hpp"
 
 namespace Yuclid {
   class Angle;
+  class BucketStats;
   class Circumcenter;
   class Collinear;
   class CyclicQuadrangle;
+  class IsOrthocenter;
   class Midpoint;
   class Point;
+  class PointGrid;
   class Problem;
+  class ShapeIndex;
   class SimilarTriangles;
   class SinOrDist;
+  class SlopeIndex;
   class Theorem;
   class Triangle;
 
+  /**
+   * @brief Numerically match theorems on a problem's diagram.
+   *
+   * Matching runs in three stages.
+   * First, we run the outer point loops of all families of theorems
+   * as independent tasks.
+   * Then we sort the candidates (triangles, angles etc),
+   * split them into buckets, and process each bucket as a task.
+   * Finally, we match the laws of sines that depend on the equal angles.
+   *
+   * Each task writes theorems to its own buffer,
+   * and the buffers are passed to the sink in a fixed order (see `TheoremStream`),
+   * so the sequence of theorems doesn't depend on the number of threads.
+   * The order follows the stages, and within a stage, the order of the tasks.
+   * A buffer is passed and freed as soon as all buffers before it are passed,
+   * so all theorems of the earlier stages are passed when a stage starts.
+   * With one thread, the running task is always the first one in the order,
+   * so at most `TheoremStream::default_flush_size` theorems are buffered.
+   * With more threads, the tasks of the current stage that finish
+   * before the first one in the order keep their theorems until it finishes.
+   * In any case, the keys of all passed theorems are kept
+   * to drop duplicates from different tasks.
+   */
   class TheoremMatcher {
   public:
     explicit TheoremMatcher(const Problem *prob, const Config::Solver *config);
-    [[nodiscard]] const std::vector<Theorem> &theorems() const {
-      return m_theorems;
+
+    /**
+     * @brief Match all theorems and move them to `sink` one by one.
+     *
+     * Should be called once.
+     */
+    void match(const TheoremSink &sink);
+
+    /**
+     * @brief Counts of the matched theorems by the name of the rule,
+     * see `Theorem::name()`.
+     *
+     * Filled by `match()`.
+     */
+    [[nodiscard]] const std::map<std::string_view, RuleStats> &rule_stats() const {
+      return m_rule_stats;
     }
+
   private:
     /**
      * @brief Numerically check the theorem, then record it as a match.
      *
-     * If both hypotheses and conclusions of `thm` are true numerically,
-     * append its normalized version to `m_theorems`.
+     * If both hypotheses and conclusions of `thm` are true numerically
+     * (see `m_verdicts`),
+     * append its normalized version to the buffer of the current task,
+     * unless the same task has inserted it before.
+     * The buffer is passed to the sink early if it's the first one in the order.
      */
     void insert_theorem(const Theorem &thm);
+
     /**
      * @brief Match theorems about similar triangles.
      *
-     * Find numerically sound statements `▵ABC ∼ ▵DEF` and `▵ABC ∼r ▵DEF`,
+     * Find numerically sound statements `▵ABC ∼ ▵DEF` and `▵ABC ∼r ▵DEF`
+     * for the pairs `(shapes[left], shapes[right])` of triangles of the same shape,
      * and add theorems about these statements.
+     *
+     * @param shapes Triangles returned by `all_triangles`.
+     * @param pairs Pairs of indexes `left < right` in `shapes`.
      */
-    void match_similar_triangles();
+    void match_similar_triangles(const ShapeIndex &shapes,
+                                 std::span<const std::pair<size_t, size_t>> pairs);
 
     /**
-     * @brief Generate all triangles with `|AB| ≤ (1 + ε)|BC| ≤ (1 + ε)²|AC|`.
+     * @brief Generate all triangles `▵ABC`
+     * with `|AB| ≤ (1 + ε)|BC| ≤ (1 + ε)²|AC|` and a given `A`.
      *
      * This function returns an `std::vector`
-     * of tuples `(|AB| / |AC|, |AB| / |BC|, ▵ABC)`
-     * over all triangles with `|AB| ≤ (1 + ε)|BC| ≤ (1 + ε)²|AC|`,
+     * of all triangles with `|AB| ≤ (1 + ε)|BC| ≤ (1 + ε)²|AC|`,
      * where `ε = REL_TOL`.
      *
-     * The tuples aren't sorted.
+     * The triangles aren't sorted.
      */
-    std::vector<std::tuple<double, double, Triangle>> all_triangles();
+    std::vector<Triangle> all_triangles(const Point &pt_a);
 
     /**
      * @brief Add theorems about a pair of similar triangles.
@@ -76,23 +136,20 @@ namespace Yuclid {
      */
     void on_similar_triangles(const SimilarTriangles& simtri);
 
-    /**
-     * @brief Process a span of pairwise similar triangles.
-     *
-     * @param bucket An `std::span` of triangles that are pairwise similar.
-     */
-    void on_span_triangles(std::span<const std::tuple<double, double, Triangle>> bucket);
-
     /**
      * @brief Generate all triples of points `(A, B, C)`
-     * with `B` between `A` and `C`, `AB ≤ (1 + ε) BC`.
+     * with `B` between `A` and `C`, `AB ≤ (1 + ε) BC`,
+     * and `max(A, C) = right`.
      *
-     * The triples are sorted by `|AB|:|AC|`.
+     * The triples aren't sorted.
      * If `|AB| ≈ |BC|`, then both `(A, B, C)` and `(C, B, A)` are returned.
      *
      * Also inserts theorems about individual triples `(A, B, C)`.
+     * With `Config::Solver::sparse_collinear()`, the triples are also appended
+     * to `collinear`, and the theorems about collinearity are left to `match_line`.
      */
-    std::vector<std::pair<double, Collinear>> sorted_between();
+    std::vector<std::pair<double, Collinear>> all_between(const Point &right,
+                                                          std::vector<std::array<Point, 3>> &collinear);
 
     /**
      * @brief Add theorems about a single triple of points `(A, B, C)`,
@@ -103,6 +160,18 @@ namespace Yuclid {
      */
     void on_between(const Collinear &pred);
 
+    /**
+     * @brief Add `coll`/`para` theorems about a collinear triple.
+     */
+    void on_collinear(const Collinear &pred);
+
+    /**
+     * @brief Add `coll`/`para` theorems about the spanning triples of a line.
+     *
+     * @param line Sorted points of a line returned by `LineRegistry`.
+     */
+    void match_line(const std::vector<Point> &line);
+
     /**
      * @brief Add theorems about 2 pairs of collinear triples with the same ratio.
      */
@@ -115,18 +184,44 @@ namespace Yuclid {
     void on_midpoint(const Midpoint &pred);
 
     /**
-     * @brief Run theorem matchers based on "between" triples.
+     * @brief Run theorem matchers based on pairs of "between" triples.
+     *
+     * @param bucket A bucket of triples with approximately equal ratios.
      */
-    void match_between();
+    void match_between(std::span<const std::pair<double, Collinear>> bucket);
 
     /**
-     * @brief Match theorems based on equality of angles.
+     * @brief Match theorems based on equality of angles in a bucket.
+     *
+     * Also inserts the angles that are equal to other angles
+     * to `important_angles`, and the cyclic quadrangles to `cyclic`.
      */
-    std::unordered_set<SinOrDist, boost::hash<SinOrDist>> match_equal_angles();
+    void match_equal_angles(std::span<const std::pair<double, Angle>> bucket,
+                            std::unordered_set<SinOrDist, boost::hash<SinOrDist>> &important_angles,
+                            std::vector<std::array<Point, 4>> &cyclic);
 
-    std::vector<std::pair<double, Angle>> all_angles();
+    /**
+     * @brief Match theorems about angles with known values.
+     *
+     * @param all All angles, sorted by value.
+     */
+    void match_special_angles(const std::vector<std::pair<double, Angle>> &all);
+
+    /**
+     * @brief Generate all nondegenerate angles `∠ABC` with a given `A`.
+     */
+    std::vector<std::pair<double, Angle>> all_angles(const Point &left);
 
-    void on_equal_angles(const Angle &left, const Angle &right);
+    void on_equal_angles(const Angle &left, const Angle &right,
+                         std::vector<std::array<Point, 4>> &cyclic);
+
+    /**
+     * @brief Match theorems about the quadrangles of a circle.
+     *
+     * @param circle Sorted points of a circle returned by `CircleRegistry`.
+     * Only the quadrangles selected by `CircleRegistry::uses_quadrangle` are used.
+     */
+    void match_cyclic(const std::vector<Point> &circle);
 
     void on_cyclic(const CyclicQuadrangle &pred);
 
@@ -141,9 +236,15 @@ namespace Yuclid {
 
     void on_point_on_bisector(const Point &point, const Angle &angle);
 
-    void match_law_sin(const std::unordered_set<SinOrDist, boost::hash<SinOrDist>> &angles);
+    void match_law_sin(const std::unordered_set<SinOrDist, boost::hash<SinOrDist>> &angles,
+                       const Point &pt_c);
 
-    void match_circles();
+    /**
+     * @brief Match theorems about points at equal distances from `center`.
+     *
+     * The sizes of the buckets of equal distances are counted in `stats`.
+     */
+    void match_circles(const Point &center, BucketStats &stats);
 
     void on_circle(const Point &center,
                    std::span<const std::pair<double, Point>> points);
@@ -156,15 +257,41 @@ namespace Yuclid {
 
     void on_quadrangle_circumcenter(const Point &center, const CyclicQuadrangle &cyc);
 
-    void match_parallelograms();
+    /**
+     * @brief Match the parallelogram law for candidate quadruples `(D, C, A, B)`.
+     */
+    void match_parallelograms(std::span<const std::array<size_t, 4>> candidates);
 
-    void match_perpendiculars();
+    /**
+     * @brief Match `AB ⟂ CD` for `A, C, D < B`, `C < D`.
+     *
+     * Only the pairs `CD` returned by `slopes` are tested numerically.
+     */
+    void match_perpendiculars(const Point &pt_b, const SlopeIndex &slopes);
+
+    /**
+     * @brief Find all `D` that are orthocenters of `▵ABC`, `A < B < C < D`.
+     *
+     * Computes the orthocenter of each triangle and looks it up in `grid`.
+     *
+     * @return Pairs `(D, ▵ABC)` ordered by `B`, then by `A`.
+     */
+    std::vector<std::pair<Point, Triangle>> all_orthocenters(const Point &pt_c, const PointGrid &grid);
 
-    void match_orthocenters();
+    /**
+     * @brief Add theorems about an orthocenter.
+     */
+    void on_orthocenter(const IsOrthocenter &pred);
 
     const Problem *m_problem;
     const Config::Solver *m_config;
 
-    std::vector<Theorem> m_theorems;
+    /** Filled with the goals before matching, and with cyclic quadrangles in stage 3. */
+    CircleRegistry m_circles;
+
+    std::map<std::string_view, RuleStats> m_rule_stats;
+
+    /** Verdicts of the hypotheses and conclusions of the theorems checked by `insert_theorem`. */
+    VerdictCache m_verdicts;
   };
 }
@@ -0,0 +1,38 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <atomic>
+#include <utility>
+#include "numbers/hybrid_int.hpp"
+
+using namespace std;
+
+namespace Yuclid::detail {
+
+  const BigNode *make_big_node(BigInt &&val) {
+    return new BigNode{.value = std::move(val)}; // NOLINT(cppcoreguidelines-owning-memory)
+  }
+
+  void retain_big_node(const BigNode *node) noexcept {
+    node->refs.fetch_add(1, memory_order_relaxed);
+  }
+
+  void release_big_node(const BigNode *node) noexcept {
+    if (node->refs.fetch_sub(1, memory_order_acq_rel) == 1) {
+      delete node; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+  }
+
+}
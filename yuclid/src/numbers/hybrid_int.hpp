@@ -0,0 +1,618 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file Integers with a machine word fast path.
+ */
+
+namespace Yuclid {
+  template <std::integral Small> class HybridInt;
+}
+
+// `boost::rational` calls `boost::integer::gcd` by its qualified name,
+// so our overloads must be declared before `numbers/rational.hpp`.
+// This also has to happen before `boost/multiprecision`
+// pulls in the upstream `boost/rational.hpp`.
+namespace boost::integer {
+  template <std::integral Small>
+  constexpr Yuclid::HybridInt<Small> gcd(const Yuclid::HybridInt<Small> &a,
+                                         const Yuclid::HybridInt<Small> &b);
+
+  template <std::integral Small>
+  constexpr Yuclid::HybridInt<Small> lcm(const Yuclid::HybridInt<Small> &a,
+                                         const Yuclid::HybridInt<Small> &b);
+}
+
+#include "numbers/rational.hpp"
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+
+namespace Yuclid {
+
+  /** Arbitrary precision integers used when a value doesn't fit into a machine word. */
+  using BigInt = boost::multiprecision::cpp_int;
+
+  namespace detail {
+
+    /** @brief A reference counted `BigInt`, shared by the copies of a `HybridInt`. */
+    struct BigNode {
+      BigInt value;
+      mutable std::atomic<std::size_t> refs{1};
+    };
+
+    /** @brief Allocate a node holding `val`, with one reference. */
+    const BigNode *make_big_node(BigInt &&val);
+
+    /** @brief Add a reference to `node`. Thread safe. */
+    void retain_big_node(const BigNode *node) noexcept;
+
+    /** @brief Drop a reference to `node`, freeing it with the last one. Thread safe. */
+    void release_big_node(const BigNode *node) noexcept;
+
+    /**
+     * @brief Compute `a + b`, return `true` on overflow.
+     *
+     * On overflow, the value of `res` is unspecified.
+     */
+    template <std::integral T>
+    constexpr bool add_overflow(T a, T b, T &res) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_add_overflow(a, b, &res);
+#else
+      if constexpr (std::is_signed_v<T>) {
+        if ((b > 0 && a > std::numeric_limits<T>::max() - b) ||
+            (b < 0 && a < std::numeric_limits<T>::min() - b)) {
+          return true;
+        }
+      } else if (a > std::numeric_limits<T>::max() - b) {
+        return true;
+      }
+      res = a + b;
+      return false;
+#endif
+    }
+
+    /** @brief Compute `a - b`, return `true` on overflow. */
+    template <std::integral T>
+    constexpr bool sub_overflow(T a, T b, T &res) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_sub_overflow(a, b, &res);
+#else
+      if constexpr (std::is_signed_v<T>) {
+        if ((b < 0 && a > std::numeric_limits<T>::max() + b) ||
+            (b > 0 && a < std::numeric_limits<T>::min() + b)) {
+          return true;
+        }
+      } else if (a < b) {
+        return true;
+      }
+      res = a - b;
+      return false;
+#endif
+    }
+
+    /** @brief Compute `a * b`, return `true` on overflow. */
+    template <std::integral T>
+    constexpr bool mul_overflow(T a, T b, T &res) {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_mul_overflow(a, b, &res);
+#else
+      constexpr T max = std::numeric_limits<T>::max();
+      constexpr T min = std::numeric_limits<T>::min();
+      if constexpr (std::is_signed_v<T>) {
+        if (a > 0) {
+          if ((b > 0 && a > max / b) || (b < 0 && b < min / a)) {
+            return true;
+          }
+        } else if (a < 0) {
+          if ((b > 0 && a < min / b) || (b < 0 && b < max / a)) {
+            return true;
+          }
+        }
+      } else if (b != 0 && a > max / b) {
+        return true;
+      }
+      res = a * b;
+      return false;
+#endif
+    }
+  }
+
+  /**
+   * @brief An integer that is stored inline while it fits into `Small`,
+   * and is promoted to `BigInt` otherwise.
+   *
+   * All arithmetic operations check for overflow.
+   * If the result of an operation on two inline values fits into `Small`,
+   * then we never touch the heap.
+   * Otherwise, we redo the operation with `BigInt`s
+   * and demote the result back to `Small` if it fits.
+   * Thus the representation is unique:
+   * `m_big` is not null if and only if the value doesn't fit into `Small`.
+   *
+   * Values that don't fit live in a reference counted `detail::BigNode`,
+   * shared by copies and freed with the last of them.
+   * Copying an inline value only tests `m_big`,
+   * so the fast path costs about the same as for a plain `Small`.
+   *
+   * For an unsigned `Small`, an operation with a negative result
+   * throws `std::range_error`.
+   */
+  template <std::integral Small>
+  class HybridInt {
+  public:
+    using SmallType = Small;
+
+    constexpr HybridInt() = default;
+
+    constexpr HybridInt(const HybridInt &other) : m_small(other.m_small), m_big(other.m_big) {
+      if (m_big != nullptr) [[unlikely]] {
+        detail::retain_big_node(m_big);
+      }
+    }
+
+    constexpr HybridInt(HybridInt &&other) noexcept
+        : m_small(other.m_small), m_big(std::exchange(other.m_big, nullptr)) {}
+
+    constexpr HybridInt &operator=(const HybridInt &other) {
+      // Retain first, so that self-assignment keeps the node alive.
+      const detail::BigNode *big = other.m_big;
+      if (big != nullptr) [[unlikely]] {
+        detail::retain_big_node(big);
+      }
+      reset();
+      m_small = other.m_small;
+      m_big = big;
+      return *this;
+    }
+
+    constexpr HybridInt &operator=(HybridInt &&other) noexcept {
+      if (this != &other) {
+        reset();
+        m_small = other.m_small;
+        m_big = std::exchange(other.m_big, nullptr);
+      }
+      return *this;
+    }
+
+    constexpr ~HybridInt() { reset(); }
+
+    /** @brief Implicit conversion from builtin integer types. */
+    template <std::integral U>
+      requires (!std::same_as<U, bool>)
+    constexpr HybridInt(U val) {  // NOLINT(google-explicit-constructor)
+      if (std::in_range<Small>(val)) {
+        m_small = static_cast<Small>(val);
+      } else {
+        *this = from_big(BigInt(val));
+      }
+    }
+
+    /** @brief Conversion between signed and unsigned versions. */
+    template <std::integral U>
+      requires (!std::same_as<U, Small>)
+    constexpr HybridInt(const HybridInt<U> &other) {  // NOLINT(google-explicit-constructor)
+      if (other.is_small()) {
+        *this = HybridInt(other.small());
+      } else {
+        *this = from_big(BigInt(other.big()));
+      }
+    }
+
+    explicit HybridInt(const BigInt &val) : HybridInt(from_big(BigInt(val))) {}
+
+    /** Returns `true` if the value is stored inline. */
+    [[nodiscard]] constexpr bool is_small() const { return m_big == nullptr; }
+
+    /** Returns the inline value. Only valid if `is_small()`. */
+    [[nodiscard]] constexpr Small small() const { return m_small; }
+
+    /** Returns the big value. Only valid if `!is_small()`. */
+    [[nodiscard]] const BigInt &big() const { return m_big->value; }
+
+    /** Returns the value as a `BigInt`, regardless of the representation. */
+    [[nodiscard]] BigInt to_big() const {
+      return is_small() ? BigInt(m_small) : m_big->value;
+    }
+
+    /**
+     * @brief Create a `HybridInt` from a `BigInt`,
+     * demoting it to `Small` if it fits.
+     */
+    static HybridInt from_big(BigInt &&val) {
+      HybridInt res;
+      if constexpr (std::is_unsigned_v<Small>) {
+        if (val.sign() < 0) {
+          throw std::range_error("Negative result of an operation on unsigned integers");
+        }
+      }
+      if (val >= std::numeric_limits<Small>::min() &&
+          val <= std::numeric_limits<Small>::max()) {
+        res.m_small = val.template convert_to<Small>();
+      } else {
+        res.m_big = detail::make_big_node(std::move(val));
+      }
+      return res;
+    }
+
+    /**
+     * @brief Explicit conversion to builtin integer types.
+     *
+     * Throws `std::overflow_error` if the value doesn't fit.
+     */
+    template <std::integral U>
+      requires (!std::same_as<U, bool>)
+    constexpr explicit operator U() const {
+      if (is_small()) {
+        if (std::in_range<U>(m_small)) {
+          return static_cast<U>(m_small);
+        }
+      } else if (big() >= std::numeric_limits<U>::min() &&
+                 big() <= std::numeric_limits<U>::max()) {
+        return big().template convert_to<U>();
+      }
+      throw std::overflow_error("Integer doesn't fit into a machine word: " + str());
+    }
+
+    explicit operator double() const {
+      return is_small() ? static_cast<double>(m_small) : big().template convert_to<double>();
+    }
+
+    constexpr explicit operator bool() const {
+      return !is_small() || m_small != 0;
+    }
+
+    [[nodiscard]] std::string str() const {
+      return is_small() ? std::to_string(m_small) : big().str();
+    }
+
+    /**
+     * @brief The number of bits needed to represent a nonnegative value.
+     */
+    [[nodiscard]] std::size_t bit_width() const {
+      if (is_small()) {
+        return std::bit_width(static_cast<std::make_unsigned_t<Small>>(m_small));
+      }
+      return boost::multiprecision::msb(big()) + 1;
+    }
+
+    friend constexpr HybridInt operator+(const HybridInt &a, const HybridInt &b) {
+      Small res{};
+      if (a.is_small() && b.is_small() && !detail::add_overflow(a.m_small, b.m_small, res)) [[likely]] {
+        return HybridInt(SmallTag{}, res);
+      }
+      return slow_add(a, b);
+    }
+
+    friend constexpr HybridInt operator-(const HybridInt &a, const HybridInt &b) {
+      Small res{};
+      if (a.is_small() && b.is_small() && !detail::sub_overflow(a.m_small, b.m_small, res)) [[likely]] {
+        return HybridInt(SmallTag{}, res);
+      }
+      return slow_sub(a, b);
+    }
+
+    friend constexpr HybridInt operator*(const HybridInt &a, const HybridInt &b) {
+      Small res{};
+      if (a.is_small() && b.is_small() && !detail::mul_overflow(a.m_small, b.m_small, res)) [[likely]] {
+        return HybridInt(SmallTag{}, res);
+      }
+      return slow_mul(a, b);
+    }
+
+    /** @brief Division rounding towards zero, as for builtin types. */
+    friend constexpr HybridInt operator/(const HybridInt &a, const HybridInt &b) {
+      if (a.is_small() && b.is_small() && b.m_small != 0 && !a.is_min_div_minus_one(b)) [[likely]] {
+        return HybridInt(SmallTag{}, static_cast<Small>(a.m_small / b.m_small));
+      }
+      return slow_div(a, b);
+    }
+
+    /** @brief Remainder with the sign of the dividend, as for builtin types. */
+    friend constexpr HybridInt operator%(const HybridInt &a, const HybridInt &b) {
+      if (a.is_small() && b.is_small() && b.m_small != 0 && !a.is_min_div_minus_one(b)) [[likely]] {
+        return HybridInt(SmallTag{}, static_cast<Small>(a.m_small % b.m_small));
+      }
+      return slow_mod(a, b);
+    }
+
+    constexpr HybridInt operator-() const {
+      return HybridInt() - *this;
+    }
+
+    constexpr HybridInt operator+() const {
+      return *this;
+    }
+
+    constexpr HybridInt &operator+=(const HybridInt &other) {
+      Small res{};
+      if (is_small() && other.is_small() && !detail::add_overflow(m_small, other.m_small, res)) [[likely]] {
+        m_small = res;
+        return *this;
+      }
+      return *this = slow_add(*this, other);
+    }
+
+    constexpr HybridInt &operator-=(const HybridInt &other) {
+      Small res{};
+      if (is_small() && other.is_small() && !detail::sub_overflow(m_small, other.m_small, res)) [[likely]] {
+        m_small = res;
+        return *this;
+      }
+      return *this = slow_sub(*this, other);
+    }
+
+    constexpr HybridInt &operator*=(const HybridInt &other) {
+      Small res{};
+      if (is_small() && other.is_small() && !detail::mul_overflow(m_small, other.m_small, res)) [[likely]] {
+        m_small = res;
+        return *this;
+      }
+      return *this = slow_mul(*this, other);
+    }
+
+    constexpr HybridInt &operator/=(const HybridInt &other) {
+      return *this = *this / other;
+    }
+
+    constexpr HybridInt &operator%=(const HybridInt &other) {
+      return *this = *this % other;
+    }
+
+    constexpr HybridInt &operator++() {
+      return *this += HybridInt(SmallTag{}, 1);
+    }
+
+    constexpr HybridInt &operator--() {
+      return *this -= HybridInt(SmallTag{}, 1);
+    }
+
+    constexpr HybridInt operator++(int) {
+      HybridInt res(*this);
+      ++*this;
+      return res;
+    }
+
+    constexpr HybridInt operator--(int) {
+      HybridInt res(*this);
+      --*this;
+      return res;
+    }
+
+    friend constexpr bool operator==(const HybridInt &a, const HybridInt &b) {
+      if (a.is_small() && b.is_small()) [[likely]] {
+        return a.m_small == b.m_small;
+      }
+      // The representation is unique, so a big value never equals an inline one.
+      return !a.is_small() && !b.is_small() && a.big() == b.big();
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const HybridInt &a, const HybridInt &b) {
+      if (a.is_small() && b.is_small()) [[likely]] {
+        return a.m_small <=> b.m_small;
+      }
+      return a.to_big().compare(b.to_big()) <=> 0;
+    }
+
+    /**
+     * @brief Greatest common divisor of `|a|` and `|b|`.
+     *
+     * Uses `std::gcd` on the magnitudes for inline values.
+     */
+    static constexpr HybridInt gcd(const HybridInt &a, const HybridInt &b) {
+      if (a.is_small() && b.is_small()) [[likely]] {
+        return HybridInt(std::gcd(a.magnitude(), b.magnitude()));
+      }
+      return slow_gcd(a, b);
+    }
+
+    /** @brief Least common multiple of `|a|` and `|b|`. */
+    static constexpr HybridInt lcm(const HybridInt &a, const HybridInt &b) {
+      if (!a || !b) {
+        return HybridInt();
+      }
+      HybridInt res = a / gcd(a, b) * b;
+      return res < HybridInt() ? -res : res;
+    }
+
+    friend std::size_t hash_value(const HybridInt &val) {
+      if (val.is_small()) {
+        return boost::hash_value(val.m_small);
+      }
+      return boost::multiprecision::hash_value(val.big());
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const HybridInt &val) {
+      if (val.is_small()) {
+        return out << val.m_small;
+      }
+      return out << val.big();
+    }
+
+    /** @brief Read an optionally signed sequence of decimal digits. */
+    friend std::istream &operator>>(std::istream &in, HybridInt &val) {
+      const std::istream::sentry sentry(in);
+      if (!sentry) {
+        return in;
+      }
+      std::string digits;
+      if (in.peek() == '-' || in.peek() == '+') {
+        digits += static_cast<char>(in.get());
+      }
+      while (std::isdigit(in.peek()) != 0) {
+        digits += static_cast<char>(in.get());
+      }
+      if (digits.empty() || std::isdigit(static_cast<unsigned char>(digits.back())) == 0) {
+        in.setstate(std::ios_base::failbit);
+        return in;
+      }
+      val = from_big(BigInt(digits));
+      return in;
+    }
+
+  private:
+    struct SmallTag {};
+
+    // The slow paths are kept out of line,
+    // so that the fast paths are small enough to be inlined.
+    BOOST_NOINLINE static HybridInt slow_add(HybridInt a, HybridInt b) {
+      return from_big(a.to_big() + b.to_big());
+    }
+
+    BOOST_NOINLINE static HybridInt slow_sub(HybridInt a, HybridInt b) {
+      return from_big(a.to_big() - b.to_big());
+    }
+
+    BOOST_NOINLINE static HybridInt slow_mul(HybridInt a, HybridInt b) {
+      return from_big(a.to_big() * b.to_big());
+    }
+
+    BOOST_NOINLINE static HybridInt slow_div(HybridInt a, HybridInt b) {
+      if (!b) {
+        throw std::domain_error("Division by zero");
+      }
+      return from_big(a.to_big() / b.to_big());
+    }
+
+    BOOST_NOINLINE static HybridInt slow_mod(HybridInt a, HybridInt b) {
+      if (!b) {
+        throw std::domain_error("Division by zero");
+      }
+      return from_big(a.to_big() % b.to_big());
+    }
+
+    BOOST_NOINLINE static HybridInt slow_gcd(HybridInt a, HybridInt b) {
+      return from_big(boost::multiprecision::gcd(a.to_big(), b.to_big()));
+    }
+
+    constexpr HybridInt(SmallTag /* tag */, Small val) : m_small(val) {}
+
+    /** Drops the reference to the big value, if any. */
+    constexpr void reset() {
+      if (m_big != nullptr) [[unlikely]] {
+        detail::release_big_node(std::exchange(m_big, nullptr));
+      }
+    }
+
+    /** Returns `true` if `*this / other` overflows `Small`. */
+    [[nodiscard]] constexpr bool is_min_div_minus_one(const HybridInt &other) const {
+      if constexpr (std::is_signed_v<Small>) {
+        return m_small == std::numeric_limits<Small>::min() && other.m_small == -1;
+      } else {
+        return false;
+      }
+    }
+
+    /** Returns `|m_small|` as an unsigned integer. Only valid if `is_small()`. */
+    [[nodiscard]] constexpr std::make_unsigned_t<Small> magnitude() const {
+      using Unsigned = std::make_unsigned_t<Small>;
+      if constexpr (std::is_signed_v<Small>) {
+        if (m_small < 0) {
+          return Unsigned(0) - static_cast<Unsigned>(m_small);
+        }
+      }
+      return static_cast<Unsigned>(m_small);
+    }
+
+    Small m_small{0};
+    const detail::BigNode *m_big{nullptr};
+  };
+
+  /**
+   * @brief Compute `num / den` as a `double`,
+   * even if both are too large for a `double`.
+   */
+  template <std::integral Small>
+  double ratio_to_double(const HybridInt<Small> &num, const HybridInt<Small> &den) {
+    if (num.is_small() && den.is_small()) [[likely]] {
+      return static_cast<double>(num.small()) / static_cast<double>(den.small());
+    }
+    return boost::multiprecision::cpp_rational(num.to_big(), den.to_big()).template convert_to<double>();
+  }
+
+  static_assert(sizeof(HybridInt<std::int64_t>) == 2 * sizeof(std::int64_t));
+}
+
+namespace std {
+  template <std::integral Small>
+  class numeric_limits<Yuclid::HybridInt<Small>> {
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = numeric_limits<Small>::is_signed;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = false;
+    static constexpr bool is_modulo = false;
+    static constexpr int digits = numeric_limits<int>::max();
+    static constexpr int digits10 = numeric_limits<int>::max();
+    static constexpr int max_digits10 = 0;
+    static constexpr int radix = 2;
+    static constexpr int min_exponent = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent = 0;
+    static constexpr int max_exponent10 = 0;
+    static constexpr float_denorm_style has_denorm = denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+    static constexpr float_round_style round_style = round_toward_zero;
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+    // Same as for unbounded `boost::multiprecision` types.
+    static constexpr Yuclid::HybridInt<Small> min() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> max() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> lowest() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> epsilon() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> round_error() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> infinity() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> quiet_NaN() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> signaling_NaN() { return {}; }
+    static constexpr Yuclid::HybridInt<Small> denorm_min() { return {}; }
+  };
+}
+
+namespace boost::integer {
+  template <std::integral Small>
+  constexpr Yuclid::HybridInt<Small> gcd(const Yuclid::HybridInt<Small> &a,
+                                         const Yuclid::HybridInt<Small> &b) {
+    return Yuclid::HybridInt<Small>::gcd(a, b);
+  }
+
+  template <std::integral Small>
+  constexpr Yuclid::HybridInt<Small> lcm(const Yuclid::HybridInt<Small> &a,
+                                         const Yuclid::HybridInt<Small> &b) {
+    return Yuclid::HybridInt<Small>::lcm(a, b);
+  }
+}
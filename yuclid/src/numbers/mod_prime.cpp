@@ -0,0 +1,59 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "numbers/mod_prime.hpp"
+
+#include "typedef.hpp"
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
+using namespace std;
+
+namespace Yuclid {
+
+  ModPrime ModPrime::of_int(const Int &val) {
+    auto const rem = static_cast<UnsafeInt>(val % Int(static_cast<UnsafeInt>(modulus)));
+    return ModPrime(rem < 0 ? static_cast<uint64_t>(rem + static_cast<UnsafeInt>(modulus))
+                    : static_cast<uint64_t>(rem));
+  }
+
+  optional<ModPrime> ModPrime::of_rat(const Rat &val) {
+    ModPrime const num = of_int(val.numerator());
+    if (val.denominator() == Int(1)) {
+      return num;
+    }
+    ModPrime const den = of_int(val.denominator());
+    if (den == ModPrime()) [[unlikely]] {
+      return nullopt;
+    }
+    return num * den.inverse();
+  }
+
+  ModPrime ModPrime::inverse() const {
+    assert(m_val != 0);
+    // Fermat's little theorem: `a^(p - 2) = a^(-1)`.
+    ModPrime res(1);
+    ModPrime base = *this;
+    for (uint64_t exp = modulus - 2; exp != 0; exp >>= 1) {
+      if ((exp & 1) != 0) {
+        res *= base;
+      }
+      base *= base;
+    }
+    return res;
+  }
+
+}
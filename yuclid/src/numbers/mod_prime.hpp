@@ -0,0 +1,90 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "typedef.hpp"
+#include <compare>
+#include <cstdint>
+#include <optional>
+
+namespace Yuclid {
+
+  /**
+   * @brief A residue modulo the Mersenne prime `p = 2^61 - 1`.
+   *
+   * Used to check cheaply whether a linear equation may follow from others:
+   * if it doesn't follow modulo `p`, then it doesn't follow over the rationals.
+   * Products of two residues fit into 122 bits,
+   * and reducing modulo a Mersenne prime needs only shifts and additions.
+   */
+  class ModPrime final {
+  public:
+    static constexpr uint64_t modulus = (uint64_t{1} << 61) - 1;
+
+    constexpr ModPrime() = default;
+
+    /** @brief The residue of `val`, which should be less than `modulus`. */
+    constexpr explicit ModPrime(uint64_t val) : m_val(val) {}
+
+    /** @brief The residue of an integer. */
+    [[nodiscard]] static ModPrime of_int(const Int &val);
+
+    /**
+     * @brief The residue of a rational number.
+     *
+     * @return `nullopt` if the denominator is divisible by `modulus`.
+     */
+    [[nodiscard]] static std::optional<ModPrime> of_rat(const Rat &val);
+
+    [[nodiscard]] constexpr uint64_t value() const { return m_val; }
+
+    constexpr ModPrime &operator+=(ModPrime other) {
+      m_val += other.m_val;
+      if (m_val >= modulus) {
+        m_val -= modulus;
+      }
+      return *this;
+    }
+
+    constexpr ModPrime &operator-=(ModPrime other) {
+      m_val = m_val >= other.m_val ? m_val - other.m_val : m_val + modulus - other.m_val;
+      return *this;
+    }
+
+    constexpr ModPrime &operator*=(ModPrime other) {
+      unsigned __int128 const prod = static_cast<unsigned __int128>(m_val) * other.m_val;
+      // `2^61 = 1`, so the high bits are added to the low bits.
+      uint64_t res = static_cast<uint64_t>(prod & modulus) + static_cast<uint64_t>(prod >> 61);
+      res = (res & modulus) + (res >> 61);
+      m_val = res >= modulus ? res - modulus : res;
+      return *this;
+    }
+
+    constexpr ModPrime operator-() const { return ModPrime() -= *this; }
+
+    friend constexpr ModPrime operator+(ModPrime lhs, ModPrime rhs) { return lhs += rhs; }
+    friend constexpr ModPrime operator-(ModPrime lhs, ModPrime rhs) { return lhs -= rhs; }
+    friend constexpr ModPrime operator*(ModPrime lhs, ModPrime rhs) { return lhs *= rhs; }
+
+    /** @brief The multiplicative inverse; `*this` must be nonzero. */
+    [[nodiscard]] ModPrime inverse() const;
+
+    auto operator<=>(const ModPrime &other) const = default;
+
+  private:
+    uint64_t m_val{0};
+  };
+
+}
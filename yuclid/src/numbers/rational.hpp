@@ -799,74 +799,80 @@ bool rational<IntType>::operator< (const rational<IntType>& r) const
     BOOST_ASSERT( this->den > zero );
     BOOST_ASSERT( r.den > zero );
 
-    // Determine relative order by expanding each value to its simple continued
-    // fraction representation using the Euclidian GCD algorithm.
-    struct { int_type  n, d, q, r; }
-     ts = { this->num, this->den, static_cast<int_type>(this->num / this->den),
-     static_cast<int_type>(this->num % this->den) },
-     rs = { r.num, r.den, static_cast<int_type>(r.num / r.den),
-     static_cast<int_type>(r.num % r.den) };
-    unsigned  reverse = 0u;
-
-    // Normalize negative moduli by repeatedly adding the (positive) denominator
-    // and decrementing the quotient.  Later cycles should have all positive
-    // values, so this only has to be done for the first cycle.  (The rules of
-    // C++ require a nonnegative quotient & remainder for a nonnegative dividend
-    // & positive divisor.)
-    while ( ts.r < zero )  { ts.r += ts.d; --ts.q; }
-    while ( rs.r < zero )  { rs.r += rs.d; --rs.q; }
-
-    // Loop through and compare each variable's continued-fraction components
-    for ( ;; )
-    {
-        // The quotients of the current cycle are the continued-fraction
-        // components.  Comparing two c.f. is comparing their sequences,
-        // stopping at the first difference.
-        if ( ts.q != rs.q )
+    // Cross multiplication can't overflow an unbounded type,
+    // and it is much cheaper than the continued fractions below.
+    if constexpr (!std::numeric_limits<IntType>::is_bounded) {
+        return this->num * r.den < r.num * this->den;
+    } else {
+        // Determine relative order by expanding each value to its simple continued
+        // fraction representation using the Euclidian GCD algorithm.
+        struct { int_type  n, d, q, r; }
+         ts = { this->num, this->den, static_cast<int_type>(this->num / this->den),
+         static_cast<int_type>(this->num % this->den) },
+         rs = { r.num, r.den, static_cast<int_type>(r.num / r.den),
+         static_cast<int_type>(r.num % r.den) };
+        unsigned  reverse = 0u;
+
+        // Normalize negative moduli by repeatedly adding the (positive) denominator
+        // and decrementing the quotient.  Later cycles should have all positive
+        // values, so this only has to be done for the first cycle.  (The rules of
+        // C++ require a nonnegative quotient & remainder for a nonnegative dividend
+        // & positive divisor.)
+        while ( ts.r < zero )  { ts.r += ts.d; --ts.q; }
+        while ( rs.r < zero )  { rs.r += rs.d; --rs.q; }
+
+        // Loop through and compare each variable's continued-fraction components
+        for ( ;; )
         {
-            // Since reciprocation changes the relative order of two variables,
-            // and c.f. use reciprocals, the less/greater-than test reverses
-            // after each index.  (Start w/ non-reversed @ whole-number place.)
-            return reverse ? ts.q > rs.q : ts.q < rs.q;
-        }
+            // The quotients of the current cycle are the continued-fraction
+            // components.  Comparing two c.f. is comparing their sequences,
+            // stopping at the first difference.
+            if ( ts.q != rs.q )
+            {
+                // Since reciprocation changes the relative order of two variables,
+                // and c.f. use reciprocals, the less/greater-than test reverses
+                // after each index.  (Start w/ non-reversed @ whole-number place.)
+                return reverse ? ts.q > rs.q : ts.q < rs.q;
+            }
 
-        // Prepare the next cycle
-        reverse ^= 1u;
+            // Prepare the next cycle
+            reverse ^= 1u;
 
-        if ( (ts.r == zero) || (rs.r == zero) )
-        {
-            // At least one variable's c.f. expansion has ended
-            break;
-        }
+            if ( (ts.r == zero) || (rs.r == zero) )
+            {
+                // At least one variable's c.f. expansion has ended
+                break;
+            }
 
-        ts.n = ts.d;         ts.d = ts.r;
-        ts.q = ts.n / ts.d;  ts.r = ts.n % ts.d;
-        rs.n = rs.d;         rs.d = rs.r;
-        rs.q = rs.n / rs.d;  rs.r = rs.n % rs.d;
-    }
+            ts.n = ts.d;         ts.d = ts.r;
+            ts.q = ts.n / ts.d;  ts.r = ts.n % ts.d;
+            rs.n = rs.d;         rs.d = rs.r;
+            rs.q = rs.n / rs.d;  rs.r = rs.n % rs.d;
+        }
 
-    // Compare infinity-valued components for otherwise equal sequences
-    if ( ts.r == rs.r )
-    {
-        // Both remainders are zero, so the next (and subsequent) c.f.
-        // components for both sequences are infinity.  Therefore, the sequences
-        // and their corresponding values are equal.
-        return false;
-    }
-    else
-    {
+        // Compare infinity-valued components for otherwise equal sequences
+        if ( ts.r == rs.r )
+        {
+            // Both remainders are zero, so the next (and subsequent) c.f.
+            // components for both sequences are infinity.  Therefore, the sequences
+            // and their corresponding values are equal.
+            return false;
+        }
+        else
+        {
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable:4800)
 #endif
-        // Exactly one of the remainders is zero, so all following c.f.
-        // components of that variable are infinity, while the other variable
-        // has a finite next c.f. component.  So that other variable has the
-        // lesser value (modulo the reversal flag!).
-        return ( ts.r != zero ) != static_cast<bool>( reverse );
+            // Exactly one of the remainders is zero, so all following c.f.
+            // components of that variable are infinity, while the other variable
+            // has a finite next c.f. component.  So that other variable has the
+            // lesser value (modulo the reversal flag!).
+            return ( ts.r != zero ) != static_cast<bool>( reverse );
 #ifdef BOOST_MSVC
 #pragma warning(pop)
 #endif
+        }
     }
 }
 
@@ -908,8 +914,10 @@ BOOST_CXX14_CONSTEXPR void rational<IntType>::normalize()
     den /= g;
 
     if constexpr (std::numeric_limits<IntType>::is_signed) {
-        if (den < -(std::numeric_limits<IntType>::max)()) {
-            BOOST_THROW_EXCEPTION(bad_rational("bad rational: non-zero singular denominator"));
+        if constexpr (std::numeric_limits<IntType>::is_bounded) {
+            if (den < -(std::numeric_limits<IntType>::max)()) {
+                BOOST_THROW_EXCEPTION(bad_rational("bad rational: non-zero singular denominator"));
+            }
         }
 
         // Ensure that the denominator is positive
@@ -61,8 +61,13 @@ namespace Yuclid {
       return a;
     }
 
+#ifdef WITH_BIG_INTEGERS
+    Nat const pow2 = (a.bit_width() + n - 1) / n;
+    Nat guess = upower(Nat(2), pow2);
+#else
     UnsafeNat const pow2 = (bit_width(UnsafeNat(a)) + n - 1) / UnsafeNat(n);
     Nat guess(UnsafeNat(1) << pow2);
+#endif
     Nat next_guess = guess;
 
     do {
@@ -101,4 +106,17 @@ namespace Yuclid {
     return {1, q};
   }
 
+  size_t rat_height(const Rat &q) {
+#ifdef WITH_BIG_INTEGERS
+    Int const num = q.numerator() < Int(0) ? -q.numerator() : q.numerator();
+    return num.bit_width() + q.denominator().bit_width();
+#else
+    auto const num = static_cast<UnsafeInt>(q.numerator());
+    // Negate as unsigned, so that the minimal value doesn't overflow.
+    UnsafeNat const abs_num = num < 0 ? UnsafeNat(0) - static_cast<UnsafeNat>(num) : static_cast<UnsafeNat>(num);
+    auto const den = static_cast<UnsafeNat>(static_cast<UnsafeInt>(q.denominator()));
+    return static_cast<size_t>(bit_width(abs_num)) + static_cast<size_t>(bit_width(den));
+#endif
+  }
+
 } // namespace Yuclid
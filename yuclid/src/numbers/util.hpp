@@ -17,6 +17,8 @@
 
 #include "typedef.hpp"
 #include <array>
+#include <cstddef>
+#include <optional>
 #include <utility>
 #include <boost/algorithm/algorithm.hpp>
 
@@ -101,6 +103,29 @@ namespace Yuclid {
    */
   std::pair<Nat, NNRat> get_rational_power(const NNRat& q, const Nat& max_k);
 
+  /**
+   * @brief The height of a rational number,
+   * i.e., the total number of bits in its numerator and denominator.
+   */
+  size_t rat_height(const Rat &q);
+
+#ifdef WITH_BIG_INTEGERS
+  inline double rat2double(const Rat &q) {
+    return ratio_to_double(q.numerator(), q.denominator());
+  }
+
+  inline double nnrat2double(const NNRat &q) {
+    return ratio_to_double(q.numerator(), q.denominator());
+  }
+
+  inline std::string rat2string(const Rat &q) {
+    return std::format("{}/{}", q.numerator().str(), q.denominator().str());
+  }
+
+  inline std::string nnrat2string(const NNRat &q) {
+    return std::format("{}/{}", q.numerator().str(), q.denominator().str());
+  }
+#else
   inline double rat2double(const Rat &q) {
     return static_cast<double>(static_cast<UnsafeInt>(q.numerator())) /
       static_cast<double>(static_cast<UnsafeInt>(q.denominator()));
@@ -122,6 +147,7 @@ namespace Yuclid {
                        static_cast<UnsafeNat>(q.numerator()),
                        static_cast<UnsafeNat>(q.denominator()));
   }
+#endif
 
   inline NNRat rat2nnrat(const Rat &q) {
     return {static_cast<Nat>(q.numerator()),
@@ -0,0 +1,76 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  void run_tasks(const vector<function<void()>> &tasks, size_t num_threads) {
+    if (num_threads == 0) {
+      num_threads = max(thread::hardware_concurrency(), 1U);
+    }
+    num_threads = min(num_threads, tasks.size());
+    if (num_threads <= 1) {
+      for (const auto &task : tasks) {
+        task();
+      }
+      return;
+    }
+
+    atomic<size_t> next_task{0};
+    atomic<bool> failed{false};
+    vector<exception_ptr> errors(tasks.size());
+    auto worker = [&]() {
+      while (!failed.load(memory_order_relaxed)) {
+        size_t const ind = next_task.fetch_add(1, memory_order_relaxed);
+        if (ind >= tasks.size()) {
+          return;
+        }
+        try {
+          tasks[ind]();
+        } catch (...) {
+          errors[ind] = current_exception();
+          failed.store(true, memory_order_relaxed);
+        }
+      }
+    };
+
+    {
+      vector<jthread> threads;
+      threads.reserve(num_threads - 1);
+      for (size_t i = 1; i < num_threads; ++ i) {
+        threads.emplace_back(worker);
+      }
+      worker();
+    } // `jthread`s join here.
+
+    for (const auto &err : errors) {
+      if (err) {
+        rethrow_exception(err);
+      }
+    }
+  }
+
+}
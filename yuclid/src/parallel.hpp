@@ -0,0 +1,44 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Yuclid {
+
+  /**
+   * @brief Run independent tasks on a pool of threads.
+   *
+   * Idle threads take the next task that wasn't started yet,
+   * so tasks of very different sizes are balanced between threads.
+   * Tasks should not depend on the order they're executed in;
+   * if they produce output, each task should write to its own buffer.
+   *
+   * If `num_threads` is zero, use all hardware threads.
+   * If `num_threads` is one, or there is at most one task,
+   * then the tasks are run on the calling thread in order.
+   *
+   * If some tasks throw exceptions, then this function waits
+   * for the running tasks to finish, skips the tasks that weren't started yet,
+   * and rethrows the exception thrown by the task with the smallest index.
+   *
+   * @param tasks The tasks to run.
+   * @param num_threads The maximal number of threads to use.
+   */
+  void run_tasks(const std::vector<std::function<void()>> &tasks, size_t num_threads);
+
+}
@@ -15,9 +15,19 @@
 */
 #pragma once
 #include <istream>
+#include <string>
 
 namespace Yuclid {
   class Problem;
 
+  /**
+   * @brief Parse one line of the simple input format and add it to `prob`.
+   *
+   * A line is either `name <name>`, or `point <name> <x> <y>`,
+   * or `assume <statement>`, or `prove <statement>`.
+   * Call `Problem::build_geometry_cache` after the last line.
+   */
+  void parse_line_simple(Problem &prob, const std::string &line);
+
   [[nodiscard]] Problem parse_input_simple(std::istream &input);
 }
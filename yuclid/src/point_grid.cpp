@@ -0,0 +1,113 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "point_grid.hpp"
+
+#include "geometry_cache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  namespace {
+    vector<double> all_x(const GeometryCache &geom) {
+      vector<double> res(geom.size());
+      for (size_t i = 0; i < res.size(); ++ i) {
+        res[i] = geom.x(i);
+      }
+      return res;
+    }
+
+    vector<double> all_y(const GeometryCache &geom) {
+      vector<double> res(geom.size());
+      for (size_t i = 0; i < res.size(); ++ i) {
+        res[i] = geom.y(i);
+      }
+      return res;
+    }
+  }
+
+  PointGrid::PointGrid(const GeometryCache &geom) : PointGrid(all_x(geom), all_y(geom)) {}
+
+  PointGrid::PointGrid(vector<double> x, vector<double> y) : m_x(std::move(x)), m_y(std::move(y)) {
+    assert(m_x.size() == m_y.size());
+    size_t const num_pts = m_x.size();
+    if (num_pts == 0) {
+      return;
+    }
+    auto const [min_x, max_x] = ranges::minmax(m_x);
+    auto const [min_y, max_y] = ranges::minmax(m_y);
+    m_min_x = min_x;
+    m_min_y = min_y;
+    m_num_cells = static_cast<int64_t>(ceil(sqrt(static_cast<double>(num_pts))));
+    double const size = max(max_x - m_min_x, max_y - m_min_y);
+    if (size > 0) {
+      m_cell_size = size / static_cast<double>(m_num_cells);
+    }
+    for (size_t i = 0; i < num_pts; ++ i) {
+      m_cells[cell_of(m_x[i], m_y[i])].push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  PointGrid::Cell PointGrid::cell_of(double x, double y) const {
+    // Points on the far edge of the bounding box go to the last cell.
+    auto coord = [this](double value, double min_value) {
+      return static_cast<int64_t>(clamp(floor((value - min_value) / m_cell_size),
+                                        0.0, static_cast<double>(m_num_cells - 1)));
+    };
+    return {coord(x, m_min_x), coord(y, m_min_y)};
+  }
+
+  vector<size_t> PointGrid::points_near(double x, double y, double radius) const {
+    vector<size_t> res;
+    auto try_add = [this, x, y, radius, &res](size_t ind) {
+      if (hypot(m_x[ind] - x, m_y[ind] - y) <= radius) {
+        res.push_back(ind);
+      }
+    };
+    if (!isfinite(x) || !isfinite(y) || !isfinite(radius)) {
+      // Can't locate the cells, so test all points.
+      for (size_t ind = 0; ind < m_x.size(); ++ ind) {
+        try_add(ind);
+      }
+      return res;
+    }
+    // Cells are clamped, so a query far outside of the bounding box
+    // still looks at the boundary cells.
+    auto const [from_x, from_y] = cell_of(x - radius, y - radius);
+    auto const [to_x, to_y] = cell_of(x + radius, y + radius);
+    for (int64_t cell_x = from_x; cell_x <= to_x; ++ cell_x) {
+      for (int64_t cell_y = from_y; cell_y <= to_y; ++ cell_y) {
+        auto const it = m_cells.find(Cell{cell_x, cell_y});
+        if (it != m_cells.end()) {
+          for (uint32_t const ind : it->second) {
+            try_add(ind);
+          }
+        }
+      }
+    }
+    ranges::sort(res);
+    return res;
+  }
+
+}
@@ -0,0 +1,68 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Yuclid {
+  class GeometryCache;
+
+  /**
+   * @brief Spatial hash grid over the points of a problem.
+   *
+   * Answers "which points are near `(x, y)`" without scanning all points,
+   * e.g., to find out whether the orthocenter or another special point
+   * of a triangle is a point of the diagram.
+   *
+   * The grid can also index arbitrary locations, e.g., midpoints of segments.
+   *
+   * The cell size is chosen so that a grid over the bounding box
+   * of the points has about as many cells as there are points.
+   */
+  class PointGrid final {
+  public:
+    /** @brief Index the points of a problem. */
+    explicit PointGrid(const GeometryCache &geom);
+
+    /** @brief Index the points `(x[i], y[i])`. */
+    PointGrid(std::vector<double> x, std::vector<double> y);
+
+    /**
+     * @brief Indexes of the points at distance at most `radius` from `(x, y)`,
+     * in increasing order.
+     */
+    [[nodiscard]] std::vector<size_t> points_near(double x, double y, double radius) const;
+
+  private:
+    using Cell = std::pair<int64_t, int64_t>;
+
+    [[nodiscard]] Cell cell_of(double x, double y) const;
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    double m_min_x{0};
+    double m_min_y{0};
+    double m_cell_size{1};
+    /** Number of cells along each axis that contain points. */
+    int64_t m_num_cells{1};
+    boost::unordered_flat_map<Cell, std::vector<uint32_t>, boost::hash<Cell>> m_cells;
+  };
+
+}
@@ -15,12 +15,13 @@
 */
 #include "matcher.hpp"
 #include "problem.hpp"
+#include "problem_registry.hpp"
 #include "statement/statement.hpp"
 #include "type/point.hpp"     // To create point objects for the map
 #include "typedef.hpp"
 #include <cstddef>
 #include <memory>
-#include <stdexcept>     // For std::out_of_range exception
+#include <stdexcept>     // For std::out_of_range exception, std::runtime_error
 
 #include <boost/log/trivial.hpp>
 #include <string>
@@ -31,12 +32,59 @@ using namespace std;
 
 namespace Yuclid {
 
+  Problem::Problem(Problem &&other) noexcept :
+    m_points(std::move(other.m_points)),
+    m_hypotheses(std::move(other.m_hypotheses)),
+    m_goals(std::move(other.m_goals)),
+    m_name(std::move(other.m_name)),
+    m_geometry(std::move(other.m_geometry)),
+    m_id(std::exchange(other.m_id, ProblemRegistry::no_id)) {
+    if (m_id != ProblemRegistry::no_id) {
+      ProblemRegistry::rebind(m_id, this);
+    }
+  }
+
+  Problem &Problem::operator=(Problem &&other) noexcept {
+    if (this != &other) {
+      if (m_id != ProblemRegistry::no_id) {
+        ProblemRegistry::release(m_id);
+      }
+      m_points = std::move(other.m_points);
+      m_hypotheses = std::move(other.m_hypotheses);
+      m_goals = std::move(other.m_goals);
+      m_name = std::move(other.m_name);
+      m_geometry = std::move(other.m_geometry);
+      m_id = std::exchange(other.m_id, ProblemRegistry::no_id);
+      if (m_id != ProblemRegistry::no_id) {
+        ProblemRegistry::rebind(m_id, this);
+      }
+    }
+    return *this;
+  }
+
+  Problem::~Problem() {
+    if (m_id != ProblemRegistry::no_id) {
+      ProblemRegistry::release(m_id);
+    }
+  }
+
   Point Problem::add_point(const string &name, double x, double y) {
-    Point res(m_points.size(), this);
+    if (m_points.size() >= Point::max_points) {
+      throw runtime_error("Too many points in the problem");
+    }
+    if (m_id == ProblemRegistry::no_id) {
+      m_id = ProblemRegistry::acquire(this);
+    }
+    Point res(m_points.size(), m_id);
     m_points.emplace_back(name, x, y);
+    m_geometry.add_point(x, y);
     return res;
   }
 
+  void Problem::build_geometry_cache() {
+    m_geometry.build_tables();
+  }
+
   const string& Problem::point_name(Point pt) const {
     return m_points.at(pt.get()).name();
   }
@@ -77,7 +125,7 @@ namespace Yuclid {
     const auto size = m_points.size();
     for (size_t ind = 0; ind < size; ++ ind) {
       if (m_points[ind].name() == name) {
-        return {ind, this};
+        return {ind, m_id};
       }
     }
     throw runtime_error(format("Point named {} not found in the problem", name));
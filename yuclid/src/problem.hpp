@@ -19,6 +19,8 @@
 #include <vector>
 #include <cstddef>
 
+#include "geometry_cache.hpp"
+#include "problem_registry.hpp"
 #include "statement/statement.hpp"
 #include "type/named_point.hpp"
 #include "typedef.hpp"
@@ -44,6 +46,10 @@ namespace Yuclid {
     std::vector<std::unique_ptr<Statement>> m_goals;
     /** Name of the problem. */
     std::string m_name;
+    /** Coordinates of the points and cached distances, slopes etc. */
+    GeometryCache m_geometry;
+    /** The id stored in the points of this problem, taken when the first point is added. */
+    ProblemRegistry::Id m_id{ProblemRegistry::no_id};
 
   public:
 
@@ -54,6 +60,24 @@ namespace Yuclid {
      */
     constexpr Problem() = default;
 
+    Problem(const Problem &) = delete;
+    Problem &operator=(const Problem &) = delete;
+
+    /**
+     * @brief Move the problem together with its registry id,
+     * so existing points refer to the new instance.
+     */
+    Problem(Problem &&other) noexcept;
+    Problem &operator=(Problem &&other) noexcept;
+
+    /** @brief Returns the registry id to the pool. */
+    ~Problem();
+
+    /**
+     * @brief The id that points of this problem use to find it in `ProblemRegistry`.
+     */
+    [[nodiscard]] ProblemRegistry::Id id() const { return m_id; }
+
     /**
      * @brief Adds a point with a given name and coordinates to the problem.
      *
@@ -61,6 +85,7 @@ namespace Yuclid {
      * problem instance, throws `std::runtime_error`.
      * Otherwise, the new point's name and coordinates are added to the internal storage,
      * and the function returns the new `Point` object.
+     * Throws `std::runtime_error` if the problem already has `Point::max_points` points.
      *
      * @param name The wide string name of the point to add.
      * @param x The x-coordinate of the point, using 'double' type.
@@ -69,6 +94,19 @@ namespace Yuclid {
      */
     [[nodiscard]] Point add_point(const std::string &name, double x, double y);
 
+    /**
+     * @brief Allocate the tables of numerical data about the points.
+     *
+     * Should be called once all points are added.
+     * Adding a point after this call discards the tables.
+     */
+    void build_geometry_cache();
+
+    /**
+     * @brief Numerical data about the points of the problem.
+     */
+    [[nodiscard]] const GeometryCache &geometry() const { return m_geometry; }
+
     /**
      * @brief Set problem's name
      */
@@ -129,7 +167,7 @@ namespace Yuclid {
      */
     [[nodiscard]] auto all_points() const {
       return std::views::iota(static_cast<size_t>(0), num_points())
-        | std::views::transform([this](size_t ind) { return Point(ind, this); });
+        | std::views::transform([owner = m_id](size_t ind) { return Point(ind, owner); });
     }
 
     /**
@@ -0,0 +1,66 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "problem_registry.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  array<atomic<const Problem *>, ProblemRegistry::capacity> ProblemRegistry::s_problems{};
+
+  namespace {
+    mutex s_mutex;
+    /** Ids that were returned to the pool. */
+    vector<ProblemRegistry::Id> s_free_ids;
+    /** Ids starting from this one were never taken. */
+    size_t s_next_id = 0;
+  }
+
+  ProblemRegistry::Id ProblemRegistry::acquire(const Problem *prob) {
+    Id res = no_id;
+    {
+      lock_guard const lock(s_mutex);
+      if (!s_free_ids.empty()) {
+        res = s_free_ids.back();
+        s_free_ids.pop_back();
+      } else if (s_next_id < capacity) {
+        res = static_cast<Id>(s_next_id ++);
+      } else {
+        throw runtime_error("Too many problems with points exist at the same time");
+      }
+    }
+    rebind(res, prob);
+    return res;
+  }
+
+  void ProblemRegistry::rebind(Id id, const Problem *prob) {
+    s_problems[id].store(prob, memory_order_release); // NOLINT(*-constant-array-index)
+  }
+
+  void ProblemRegistry::release(Id id) {
+    rebind(id, nullptr);
+    lock_guard const lock(s_mutex);
+    s_free_ids.push_back(id);
+  }
+
+}
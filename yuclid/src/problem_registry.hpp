@@ -0,0 +1,69 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Yuclid {
+  class Problem;
+
+  /**
+   * @brief Process-wide table of the problems that own points.
+   *
+   * A `Point` stores a 16-bit id of its problem instead of a pointer,
+   * and finds the problem in this table when it needs coordinates or a name.
+   * A problem takes an id when its first point is added
+   * and returns it when it's destroyed.
+   *
+   * Lookups are lock-free; taking and returning ids is guarded by a mutex.
+   */
+  class ProblemRegistry final {
+  public:
+    using Id = uint16_t;
+
+    /** @brief The id of a problem that doesn't own any points. */
+    static constexpr Id no_id = std::numeric_limits<Id>::max();
+
+    /** @brief The maximal number of problems that own points at the same time. */
+    static constexpr size_t capacity = no_id;
+
+    ProblemRegistry() = delete;
+
+    /**
+     * @brief Take a free id for `prob`.
+     * @throws std::runtime_error if there are no free ids.
+     */
+    [[nodiscard]] static Id acquire(const Problem *prob);
+
+    /** @brief Point `id` to `prob`, e.g., after the problem was moved. */
+    static void rebind(Id id, const Problem *prob);
+
+    /** @brief Return `id` to the pool of free ids. */
+    static void release(Id id);
+
+    /** @brief The problem registered with `id`. */
+    [[nodiscard]] static const Problem *get(Id id) {
+      return s_problems[id].load(std::memory_order_acquire); // NOLINT(*-constant-array-index)
+    }
+
+  private:
+    static std::array<std::atomic<const Problem *>, capacity> s_problems;
+  };
+
+}
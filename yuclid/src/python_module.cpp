@@ -0,0 +1,200 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "config_options.hpp"
+#include "parser/simple.hpp"
+#include "problem.hpp"
+#include "solver/ddar_solver.hpp"
+#include "solver/statement_proof.hpp"
+#include "solver/theorem_application.hpp"
+#include "statement/statement.hpp"
+#include "theorem.hpp"
+#include <boost/json/value.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <atomic>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace py = pybind11;
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  /** @brief `(name, x, y)` */
+  using PointData = tuple<string, double, double>;
+  /** @brief `(predicate name, arguments)`, e.g., `("cong", ["a", "b", "c", "d"])` */
+  using PredicateData = pair<string, vector<string>>;
+
+  /**
+   * @brief The minimal severity of the messages we log.
+   *
+   * The logging core is global and `run_ddar` may run in several threads at once,
+   * so the filter is installed once, when the module is imported,
+   * and reads this threshold.
+   */
+  atomic<boost::log::trivial::severity_level> log_level{boost::log::trivial::warning};
+
+  /**
+   * @brief Convert a JSON value to the equivalent Python object.
+   *
+   * Must be called with the GIL held.
+   */
+  py::object to_python(const boost::json::value &val) { // NOLINT(misc-no-recursion)
+    switch (val.kind()) {
+    case boost::json::kind::null:
+      return py::none();
+    case boost::json::kind::bool_:
+      return py::bool_(val.get_bool());
+    case boost::json::kind::int64:
+      return py::int_(val.get_int64());
+    case boost::json::kind::uint64:
+      return py::int_(val.get_uint64());
+    case boost::json::kind::double_:
+      return py::float_(val.get_double());
+    case boost::json::kind::string: {
+      const auto &str = val.get_string();
+      return py::str(str.data(), str.size());
+    }
+    case boost::json::kind::array: {
+      const auto &arr = val.get_array();
+      py::list res(arr.size());
+      for (size_t i = 0; i < arr.size(); ++ i) {
+        res[i] = to_python(arr[i]);
+      }
+      return res;
+    }
+    case boost::json::kind::object: {
+      py::dict res;
+      for (const auto &item : val.get_object()) {
+        res[py::str(item.key().data(), item.key().size())] = to_python(item.value());
+      }
+      return res;
+    }
+    }
+    throw logic_error("Unknown kind of a JSON value");
+  }
+
+  /**
+   * @brief Build the problem, run DD+AR on it, return the proof.
+   *
+   * Doesn't touch Python objects, so it can run without the GIL.
+   */
+  boost::json::value run_ddar(const string &name,
+                              const vector<PointData> &points,
+                              const vector<PredicateData> &assumptions,
+                              const vector<PredicateData> &goals,
+                              const Config &config,
+                              size_t max_levels) {
+    Problem prob;
+    prob.set_name(name);
+    for (const auto &[pt_name, x, y] : points) {
+      std::ignore = prob.add_point(pt_name, x, y);
+    }
+    auto const add = [&prob](string_view action, const PredicateData &pred) {
+      string line(action);
+      line += ' ';
+      line += pred.first;
+      for (const auto &arg : pred.second) {
+        line += ' ';
+        line += arg;
+      }
+      parse_line_simple(prob, line);
+    };
+    for (const auto &pred : assumptions) {
+      add("assume", pred);
+    }
+    for (const auto &pred : goals) {
+      add("prove", pred);
+    }
+    prob.build_geometry_cache();
+
+    DDARSolver solver(&prob, &config.solver());
+    BOOST_LOG_TRIVIAL(info) << "Matched " << solver.num_theorems() << " theorems";
+    for (const auto &goal : prob.goals()) {
+      if (!goal->check_numerically()) {
+        throw runtime_error("Problem's goals failed numerical check");
+      }
+    }
+    std::ignore = solver.run(max_levels);
+    return solver.to_json();
+  }
+}
+
+PYBIND11_MODULE(_yuclid, mod) { // NOLINT
+  mod.doc() = "In-process interface to the Yuclid DD/AR engine";
+
+  boost::log::core::get()->set_filter([](const boost::log::attribute_value_set &attrs) {
+    auto const severity = attrs[boost::log::trivial::severity];
+    return !severity || *severity >= log_level.load(memory_order_relaxed);
+  });
+
+  mod.def(
+    "set_log_level",
+    [](const string &level) {
+      istringstream input(level);
+      boost::log::trivial::severity_level val{};
+      if (!(input >> val)) {
+        throw invalid_argument("Unknown log level: " + level);
+      }
+      log_level.store(val, memory_order_relaxed);
+    },
+    py::arg("level"),
+    R"doc(Set the minimal severity of the messages the solver logs to stderr.
+
+Accepts the values of `--log-level` of the `yuclid` binary, e.g., `"info"`.
+Applies to all threads; the default is `"warning"`.)doc");
+
+  mod.def(
+    "run_ddar",
+    [](const vector<PointData> &points,
+       const vector<PredicateData> &assumptions,
+       const vector<PredicateData> &goals,
+       const vector<string> &options,
+       const string &name,
+       size_t max_levels) {
+      Config const config(options);
+      boost::json::value result;
+      {
+        py::gil_scoped_release const release;
+        result = run_ddar(name, points, assumptions, goals, config, max_levels);
+      }
+      return to_python(result);
+    },
+    py::arg("points"), py::arg("assumptions"), py::arg("goals"),
+    py::arg("options") = vector<string>{}, py::arg("name") = "noname",
+    py::arg("max_levels") = 500,
+    R"doc(Run DD+AR on a problem without leaving the Python process.
+
+Points are `(name, x, y)` tuples, assumptions and goals are
+`(predicate, arguments)` pairs in the input format of the `yuclid` binary.
+`options` are the solver options of the `yuclid` binary, e.g., `["--disable-ar-sin"]`.
+`--log-level` is ignored, use `set_log_level` instead.
+
+Returns the same data as `yuclid --mode ddar --use-json`
+as a tree of Python dicts, lists, strings and numbers.
+The GIL is released while the solver runs.)doc");
+}
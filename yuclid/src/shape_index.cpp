@@ -0,0 +1,77 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "shape_index.hpp"
+
+#include "numbers/util.hpp"
+#include "type/point.hpp"
+#include "type/triangle.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  size_t ShapeIndex::insert(const Triangle &tri) {
+    size_t const ind = m_triangles.size();
+    m_triangles.push_back(tri);
+    m_shapes.push_back(shape(tri));
+    m_cells[cell_of(m_shapes.back())].push_back(static_cast<uint32_t>(ind));
+    return ind;
+  }
+
+  complex<double> ShapeIndex::shape(const Triangle &tri) {
+    complex<double> const pt_a(tri.a().x(), tri.a().y());
+    complex<double> const pt_b(tri.b().x(), tri.b().y());
+    complex<double> const pt_c(tri.c().x(), tri.c().y());
+    complex<double> const res = (pt_b - pt_a) / (pt_c - pt_a);
+    return res.imag() < 0 ? conj(res) : res;
+  }
+
+  ShapeIndex::Cell ShapeIndex::cell_of(complex<double> shape) {
+    return {static_cast<int64_t>(floor(shape.real() / EPS)),
+            static_cast<int64_t>(floor(shape.imag() / EPS))};
+  }
+
+  vector<size_t> ShapeIndex::same_shape_before(size_t ind) const {
+    vector<size_t> res;
+    complex<double> const key = m_shapes[ind];
+    auto const [cell_x, cell_y] = cell_of(key);
+    for (int64_t dx = -1; dx <= 1; ++ dx) {
+      for (int64_t dy = -1; dy <= 1; ++ dy) {
+        auto const it = m_cells.find(Cell{cell_x + dx, cell_y + dy});
+        if (it == m_cells.end()) {
+          continue;
+        }
+        for (uint32_t const other : it->second) {
+          complex<double> const diff = m_shapes[other] - key;
+          if (other < ind && abs(diff.real()) <= EPS && abs(diff.imag()) <= EPS) {
+            res.push_back(other);
+          }
+        }
+      }
+    }
+    ranges::sort(res);
+    return res;
+  }
+
+}
@@ -0,0 +1,74 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "type/triangle.hpp"
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Yuclid {
+
+  /**
+   * @brief Triangles hashed by their shape.
+   *
+   * The shape of `▵ABC` is the complex ratio `(B - A) / (C - A)`,
+   * conjugated if needed so that its imaginary part is nonnegative.
+   * Two triangles with the same shape are similar with the same order of vertices,
+   * either with the same or with the opposite orientation.
+   * The caller is responsible for choosing the order of vertices,
+   * e.g., by requiring `|AB| ≤ |BC| ≤ |AC|`.
+   *
+   * Shapes are equal if their real and imaginary parts differ by at most `EPS`.
+   * They are quantized to a grid with cells of size `EPS`,
+   * so triangles of the same shape are found by probing the neighboring cells
+   * instead of sorting all triangles.
+   * Triangles are inserted one at a time, so the caller can look up
+   * the triangles of the same shape inserted before a triangle
+   * without collecting all triangles first.
+   */
+  class ShapeIndex final {
+  public:
+    /** @brief Append `tri` to the index and return its index. */
+    size_t insert(const Triangle &tri);
+
+    /** @brief The shape of `tri`. */
+    [[nodiscard]] static std::complex<double> shape(const Triangle &tri);
+
+    [[nodiscard]] size_t size() const { return m_triangles.size(); }
+
+    [[nodiscard]] const Triangle &operator[](size_t ind) const { return m_triangles[ind]; }
+
+    /**
+     * @brief Indexes `j < ind` of the triangles with the same shape as the `ind`-th one,
+     * in increasing order.
+     */
+    [[nodiscard]] std::vector<size_t> same_shape_before(size_t ind) const;
+
+  private:
+    using Cell = std::pair<int64_t, int64_t>;
+
+    [[nodiscard]] static Cell cell_of(std::complex<double> shape);
+
+    std::vector<Triangle> m_triangles;
+    std::vector<std::complex<double>> m_shapes;
+    boost::unordered_flat_map<Cell, std::vector<uint32_t>, boost::hash<Cell>> m_cells;
+  };
+
+}
@@ -0,0 +1,111 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "slope_index.hpp"
+
+#include "geometry_cache.hpp"
+#include "numbers/util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  namespace {
+    /** Direction of the `(i, j)` pair divided by `π`, in `[0, 1)`. */
+    double slope_mod_pi(const GeometryCache &geom, size_t i, size_t j) {
+      double const res = geom.slope(i, j);
+      if (res < 0) {
+        return res + 1;
+      }
+      return res == 1 ? 0 : res;
+    }
+
+    // `Perpendicular::check_equations` compares `u.x v.x` and `-u.y v.y`
+    // up to `max(EPS, REL_TOL * max(|u.x v.x|, |u.y v.y|))`.
+    // If `|u| |v| ≥ EPS / REL_TOL`, then this tolerance is at most `REL_TOL |u| |v|`,
+    // so the angle between `u` and `v` differs from `π / 2` by less than `asin(REL_TOL)`.
+    // Shorter pairs are always returned as candidates.
+    const double min_length_product = EPS / REL_TOL;
+    // The extra term covers rounding errors in `atan2`.
+    const double slope_tolerance = (asin(REL_TOL) / numbers::pi_v<double>) + 1E-9;
+  }
+
+  SlopeIndex::SlopeIndex(const GeometryCache &geom) : m_geometry(geom) {
+    size_t const num_pts = geom.size();
+    m_by_slope.reserve(num_pts * (num_pts - 1) / 2);
+    for (size_t j = 0; j < num_pts; ++ j) {
+      for (size_t i = 0; i < j; ++ i) {
+        m_by_slope.push_back({
+            slope_mod_pi(geom, i, j),
+            geom.dist(i, j),
+            static_cast<uint32_t>(i),
+            static_cast<uint32_t>(j)
+          });
+      }
+    }
+    m_by_length = m_by_slope;
+    ranges::sort(m_by_slope, {}, &Entry::slope);
+    ranges::sort(m_by_length, {}, &Entry::length);
+  }
+
+  vector<pair<size_t, size_t>> SlopeIndex::perpendicular_candidates(size_t a, size_t b) const {
+    vector<pair<size_t, size_t>> res;
+    double const length = m_geometry.dist(a, b);
+    // Pairs shorter than this may be perpendicular to `AB` up to the absolute tolerance.
+    double const min_length = length > 0 ? min_length_product / length : INFINITY;
+    auto const short_end = ranges::lower_bound(m_by_length, min_length, {}, &Entry::length);
+    for (auto it = m_by_length.begin(); it != short_end; ++ it) {
+      res.emplace_back(it->left, it->right);
+    }
+    if (short_end == m_by_length.end()) {
+      return res;
+    }
+
+    auto add_range = [this, &res, min_length](double from, double to) {
+      auto const first = ranges::lower_bound(m_by_slope, from, {}, &Entry::slope);
+      auto const last = ranges::upper_bound(m_by_slope, to, {}, &Entry::slope);
+      for (auto it = first; it < last; ++ it) {
+        if (it->length >= min_length) {
+          res.emplace_back(it->left, it->right);
+        }
+      }
+    };
+    double target = slope_mod_pi(m_geometry, a, b) + 0.5;
+    if (target >= 1) {
+      target -= 1;
+    }
+    double const from = target - slope_tolerance;
+    double const to = target + slope_tolerance;
+    // The window may wrap around `0 ≡ 1`.
+    if (from < 0) {
+      add_range(from + 1, 1);
+      add_range(0, to);
+    } else if (to >= 1) {
+      add_range(from, 1);
+      add_range(0, to - 1);
+    } else {
+      add_range(from, to);
+    }
+    return res;
+  }
+
+}
@@ -0,0 +1,68 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Yuclid {
+  class GeometryCache;
+
+  /**
+   * @brief Pairs of points sorted by the direction of the line through them.
+   *
+   * Used to find perpendicular pairs of segments
+   * without testing all quadruples of points.
+   * Directions are taken modulo `π`,
+   * so `AB` and `BA` have the same direction.
+   */
+  class SlopeIndex final {
+  public:
+    /**
+     * @brief Index all pairs `(i, j)`, `i < j`, of the points in `geom`.
+     */
+    explicit SlopeIndex(const GeometryCache &geom);
+
+    /**
+     * @brief Pairs `(c, d)`, `c < d`, that may be perpendicular to the `(a, b)` pair.
+     *
+     * The result includes all pairs `CD`
+     * such that `Perpendicular(AB, CD).check_equations()` holds,
+     * and possibly a few more, so the caller should check the candidates.
+     * Since this check uses an absolute tolerance,
+     * pairs that are too short to have a reliable direction are always included.
+     * The pairs aren't sorted.
+     */
+    [[nodiscard]] std::vector<std::pair<size_t, size_t>> perpendicular_candidates(size_t a, size_t b) const;
+
+  private:
+    struct Entry {
+      /** Direction divided by `π`, in `[0, 1)`. */
+      double slope;
+      double length;
+      uint32_t left;
+      uint32_t right;
+    };
+
+    const GeometryCache &m_geometry;
+    /** All pairs, sorted by `slope`. */
+    std::vector<Entry> m_by_slope;
+    /** All pairs, sorted by `length`. */
+    std::vector<Entry> m_by_length;
+  };
+
+}
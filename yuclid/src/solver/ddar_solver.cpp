@@ -47,6 +47,7 @@
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -56,7 +57,11 @@ using namespace std;
 namespace Yuclid {
 
   DDARSolver::DDARSolver(const Problem *problem, const Config::Solver *config) :
-    m_problem(problem), m_config(config) {
+    m_problem(problem), m_config(config),
+    m_system_dist(config->elimination_throttle(), config->ar_union_find()),
+    m_system_squared_dist(config->elimination_throttle(), config->ar_union_find()),
+    m_system_sin_or_dist(config->elimination_throttle(), config->ar_union_find()),
+    m_system_slope_angle(config->elimination_throttle(), config->ar_union_find()) {
     BOOST_LOG_TRIVIAL(info) << "Adding `by assumption` theorems";
     // Add problem's hypotheses.
     for (const auto &hyp : problem->hypotheses()) {
@@ -66,8 +71,13 @@ namespace Yuclid {
     BOOST_LOG_TRIVIAL(info) << "Matching theorems";
     // Enqueue all numerically matching theorems.
     TheoremMatcher matcher(m_problem, m_config);
-    for (const auto &thm : matcher.theorems()) {
-      insert_theorem(thm.clone());
+    matcher.match([this](Theorem &&thm) {
+      insert_theorem(std::move(thm));
+    });
+    if (m_config->scheduler() == Config::Scheduler::WATCH) {
+      for (size_t i = 0; i < m_theorem_applications.size(); ++ i) {
+        m_scheduled_theorems.insert(m_scheduled_theorems.end(), i);
+      }
     }
 
     if (!problem->goals().empty()) {
@@ -83,11 +93,30 @@ namespace Yuclid {
     size_t num_statements = m_established_statements.size();
     BOOST_LOG_TRIVIAL(info) << format("Running level {}, starting with {} statements",
                                       m_level, num_statements);
-    // Try to make progress on each theorem.
-    size_t const n = m_theorem_applications.size();
-    for (size_t i = 0; i < n; ++ i) {
-      if (m_theorem_applications[i].get_max_point() <= max_pt) {
-        advance_theorem(i);
+    if (m_config->scheduler() == Config::Scheduler::WATCH) {
+      // Try to make progress on each theorem that was woken up.
+      // We go in the increasing order of indices, exactly as below,
+      // and theorems woken up while we're here are picked up on the same level
+      // iff they have larger indices.
+      // Since we skip only the theorems that would make no progress,
+      // this gives exactly the same proofs as the level-based scheduler.
+      size_t next = 0;
+      for (auto it = m_scheduled_theorems.begin(); it != m_scheduled_theorems.end();
+           it = m_scheduled_theorems.lower_bound(next)) {
+        size_t const i = *it;
+        next = i + 1;
+        if (m_theorem_applications[i].get_max_point() <= max_pt) {
+          m_scheduled_theorems.erase(it);
+          advance_theorem(i);
+        }
+      }
+    } else {
+      // Try to make progress on each theorem.
+      size_t const n = m_theorem_applications.size();
+      for (size_t i = 0; i < n; ++ i) {
+        if (m_theorem_applications[i].get_max_point() <= max_pt) {
+          advance_theorem(i);
+        }
       }
     }
 
@@ -131,6 +160,11 @@ namespace Yuclid {
   }
 
   ostream &DDARSolver::print_json(ostream &out) {
+    out << boost::json::serialize(to_json());
+    return out;
+  }
+
+  boost::json::value DDARSolver::to_json() {
     boost::json::array goals;
     for (auto *goal : m_goals) {
       goal->set_needed_for_goal();
@@ -144,17 +178,34 @@ namespace Yuclid {
         deductions_for_goal.push_back(val);
       }
     }
-    boost::json::value const val = {
+    return boost::json::value{
       {"status", m_solved ? "solved" : "saturated"},
       {"goals", goals},
       {"deductions_for_goal", deductions_for_goal},
       {"all_deductions", all_deductions}
     };
-    out << boost::json::serialize(val);
-    return out;
   }
 
 
+  namespace {
+    template <typename VarT>
+    void log_ar_stats(string_view name, const LinearSystem<VarT> &sys) {
+      BOOST_LOG_TRIVIAL(debug) << format("AR {} table: {} of {} exact reductions avoided by the modular check",
+                                         name, sys.num_modular_rejections(), sys.num_modular_checks());
+      auto const stats = sys.echelon_stats();
+      if (stats.num_rows == 0) {
+        return;
+      }
+      BOOST_LOG_TRIVIAL(debug) << format("AR {} table: {} rows, {:.2f} terms per row, "
+                                         "coefficients of {:.1f} bits on average and up to {} bits, "
+                                         "{} back substitution steps postponed",
+                                         name, stats.num_rows,
+                                         static_cast<double>(stats.num_terms) / static_cast<double>(stats.num_rows),
+                                         static_cast<double>(stats.total_height) / static_cast<double>(stats.num_terms),
+                                         stats.max_height, sys.num_postponed());
+    }
+  }
+
   bool DDARSolver::run(size_t max_levels) {
     if (m_problem->goals().empty()) {
       for (Point const max_pt : m_problem->all_points()) {
@@ -166,7 +217,7 @@ namespace Yuclid {
       }
       m_solved = true;
     } else {
-      auto const max_pt = Point(m_problem->num_points() - 1, m_problem);
+      auto const max_pt = Point(m_problem->num_points() - 1, m_problem->id());
       for (size_t i = 0; i < max_levels; ++ i) {
         if (!run_level(max_pt)) {
           BOOST_LOG_TRIVIAL(info) << "No new statements, stop trying";
@@ -178,6 +229,10 @@ namespace Yuclid {
         }
       }
     }
+    log_ar_stats("dist", m_system_dist);
+    log_ar_stats("squared dist", m_system_squared_dist);
+    log_ar_stats("ratio", m_system_sin_or_dist);
+    log_ar_stats("angle", m_system_slope_angle);
     return m_solved;
   }
 
@@ -222,6 +277,56 @@ namespace Yuclid {
     m_system_slope_angle.add_reduced_equation(pf);
   }
 
+  namespace {
+    /**
+     * @brief Watch the variables whose pivots or links may let `pf` make progress.
+     *
+     * These are the leading variable and the variables of the remainder,
+     * the same ones that `ReducedEquation::is_up_to_date()` checks.
+     */
+    template <typename VarT>
+    void watch_remainder_variables(LinearSystem<VarT> &sys, StatementProof *pf) {
+      const auto *eqn = pf->reduced_equation<VarT>();
+      if (eqn == nullptr) {
+        return;
+      }
+      auto const var = eqn->leading_variable();
+      if (var.has_value()) {
+        sys.watch(*var, pf);
+      }
+      for (const auto &term : eqn->remainder().lhs()) {
+        sys.watch(term.first, pf);
+      }
+    }
+  }
+
+  void DDARSolver::watch_reduced_equations(StatementProof *pf) {
+    if (m_config->scheduler() != Config::Scheduler::WATCH) {
+      return;
+    }
+    watch_remainder_variables(m_system_dist, pf);
+    watch_remainder_variables(m_system_squared_dist, pf);
+    watch_remainder_variables(m_system_sin_or_dist, pf);
+    watch_remainder_variables(m_system_slope_angle, pf);
+  }
+
+  void DDARSolver::wake_theorems(const StatementProof *pf) {
+    if (m_config->scheduler() != Config::Scheduler::WATCH) {
+      return;
+    }
+    for (size_t const i : pf->theorems_that_imply()) {
+      if (m_theorem_applications[i].state() == TheoremApplicationState::PENDING) {
+        m_scheduled_theorems.insert(i);
+      }
+    }
+    for (size_t const i : pf->theorems_that_assume()) {
+      const auto &thm = m_theorem_applications[i];
+      if (thm.state() == TheoremApplicationState::PENDING && thm.waiting_for() == pf) {
+        m_scheduled_theorems.insert(i);
+      }
+    }
+  }
+
   void DDARSolver::advance_theorem(size_t ind) {
     auto &thm = m_theorem_applications.at(ind);
     if (thm.state() != TheoremApplicationState::PENDING) {
@@ -314,7 +419,7 @@ namespace Yuclid {
       }
     };
     for (const auto &v : m_system_dist.new_found_variables()) {
-      Rat const r = m_system_dist.echelon_form().find(v)->second.rhs().rhs();
+      Rat const r = m_system_dist.found_value(v);
       if (r != Rat(0)) [[likely]] {
         f(make_unique<SquaredDistEq>(SquaredDist(v), rat2nnrat(r * r)));
       } else {
@@ -323,7 +428,7 @@ namespace Yuclid {
     }
     m_system_dist.clear_new_found_variables();
     for (const auto &v : m_system_squared_dist.new_found_variables()) {
-      Rat const r = m_system_squared_dist.echelon_form().find(v)->second.rhs().rhs();
+      Rat const r = m_system_squared_dist.found_value(v);
       if (r != Rat(0)) [[likely]] {
         f(make_unique<SquaredDistEq>(v, rat2nnrat(r)));
       } else {
@@ -340,7 +445,7 @@ namespace Yuclid {
       }
 
       const NNRat r =
-        m_system_sin_or_dist.echelon_form().find(v)->second.rhs().rhs().as_nnrat();
+        m_system_sin_or_dist.found_value(v).as_nnrat();
       if (r != NNRat(0)) [[likely]] {
         f(make_unique<SquaredDistEq>(v.get_squared_dist(), r));
       }
@@ -361,14 +466,15 @@ namespace Yuclid {
 
   StatementProof *DDARSolver::insert_statement(const std::unique_ptr<Statement> &p) {
     auto val = p->normalize();
-    auto key = val->data();
-    auto [iter, success] = m_statement_proofs.insert({
-        key, StatementProof(this, std::move(val))
-      });
-    if (success) {
-      iter->second.initial_progress();
+    auto [iter, success] = m_statement_index.try_emplace(StatementKey(*val),
+                                                         m_statement_proofs.size());
+    if (!success) {
+      return m_statement_proofs[iter->second].get();
     }
-    return &(iter->second);
+    auto *proof = m_statement_proofs.emplace_back(
+      make_unique<StatementProof>(this, std::move(val))).get();
+    proof->initial_progress();
+    return proof;
   }
 
   size_t DDARSolver::num_theorems() const {
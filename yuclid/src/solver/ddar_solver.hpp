@@ -15,10 +15,13 @@
 */
 #pragma once
 #include "ar/linear_system.hpp"
+#include "statement/statement_key.hpp"
 #include "type/variable_types.hpp"
 #include "typedef.hpp"
 #include "config_options.hpp"
+#include <boost/json/value.hpp>
 #include <boost/preprocessor.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
 #include <map>
 #include <memory>
 #include <set>
@@ -29,7 +32,6 @@ namespace Yuclid {
   class StatementProof;
   class TheoremApplication;
   class Statement;
-  struct StatementData;
   template <typename VarT> class ReducedEquation;
 
   /** @brief The main proof state manager class.
@@ -52,6 +54,13 @@ namespace Yuclid {
     std::ostream &print_proof(std::ostream & /*out*/);
     std::ostream &print_json(std::ostream & /*out*/);
 
+    /**
+     * @brief The proof in the format printed by `print_json`.
+     *
+     * Marks the statements needed for the goals as a side effect.
+     */
+    [[nodiscard]] boost::json::value to_json();
+
     /** Get the current proof level. */
     size_t get_level() const { return m_level; }
 
@@ -86,6 +95,18 @@ namespace Yuclid {
 
     size_t num_theorems() const;
 
+    /**
+     * @brief Number of pending and established statements.
+     *
+     * We never erase statements, so this is also the peak number of statements.
+     */
+    [[nodiscard]] size_t num_statements() const { return m_statement_proofs.size(); }
+
+    /** @brief Number of established statements. */
+    [[nodiscard]] size_t num_established_statements() const {
+      return m_established_statements.size();
+    }
+
     /**
      * @brief Push an already established statement to the global list of proved facts.
      *
@@ -129,6 +150,24 @@ namespace Yuclid {
      */
     void add_established_equations(StatementProof *pf);
 
+    /**
+     * @brief Schedule the pending theorems that wait for `pf`.
+     *
+     * A theorem waits for all its conclusions
+     * and for the first hypothesis that isn't proved yet.
+     * Other statements can't change the outcome of `advance_proof()`.
+     *
+     * Does nothing unless the watch-list scheduler is enabled.
+     */
+    void wake_theorems(const StatementProof *pf);
+
+    /**
+     * @brief Ask the AR tables to notify `pf` when its equations can be reduced further.
+     *
+     * Does nothing unless the watch-list scheduler is enabled.
+     */
+    void watch_reduced_equations(StatementProof *pf);
+
   protected:
     /**
      * @brief Process one theorem.
@@ -176,18 +215,29 @@ namespace Yuclid {
     /**
      * @brief Pending and completed theorem proofs.
      *
-     * Current, `class Theorem` does not support `operator<`,
-     * so we do not deduplicate the theorems.
-     * On the one hand, we try not to generate duplicate theorems.
-     * On the other hand, this shouldn't be a big issue,
-     * since we're deduplicating theorems' hypotheses and conclusions,
-     * and making 0 progress on an AR equation
-     * is just one lookup in `std::map`.
+     * The matcher drops duplicate theorems using `TheoremKey`,
+     * so each theorem is applied once.
      */
     std::vector<TheoremApplication> m_theorem_applications;
 
-    /** Pending and completed statement proofs. */
-    std::map<StatementData, StatementProof> m_statement_proofs;
+    /**
+     * @brief Theorems that may make progress on the next attempt.
+     *
+     * Only used by the watch-list scheduler.
+     * A theorem is removed from this set when we try to advance it,
+     * and is added back by `wake_theorems()`.
+     */
+    std::set<size_t> m_scheduled_theorems;
+
+    /**
+     * @brief Pending and completed statement proofs, in the order of insertion.
+     *
+     * Pointers to the proofs stay valid until `this` is destroyed.
+     */
+    std::vector<std::unique_ptr<StatementProof>> m_statement_proofs;
+
+    /** @brief Index of each normalized statement in `m_statement_proofs`. */
+    boost::unordered_flat_map<StatementKey, size_t, boost::hash<StatementKey>> m_statement_index;
 
     /** The set of statements that are the problem's goals.
      *
@@ -86,33 +86,34 @@ namespace Yuclid {
       return;
     }
     if (m_dist_eqn.second != nullptr) {
-      m_dist_eqn.second->reduce();
-      if (m_dist_eqn.second->is_solved()) {
+      if (m_dist_eqn.second->reduce_if_solvable()) {
         set_proved(PROVED_AR_DIST);
         return;
       }
     }
     if (m_squared_dist_eqn.second != nullptr) {
-      m_squared_dist_eqn.second->reduce();
-      if (m_squared_dist_eqn.second->is_solved()) {
+      if (m_squared_dist_eqn.second->reduce_if_solvable()) {
         set_proved(PROVED_AR_SQUARE_DIST);
         return;
       }
     }
     if (m_sin_or_dist_eqn.second != nullptr) {
-      m_sin_or_dist_eqn.second->reduce();
-      if (m_sin_or_dist_eqn.second->is_solved()) {
+      if (m_sin_or_dist_eqn.second->reduce_if_solvable()) {
         set_proved(PROVED_AR_RATIO);
         return;
       }
     }
     if (m_slope_angle_eqn.second != nullptr) {
-      m_slope_angle_eqn.second->reduce();
-      if (m_slope_angle_eqn.second->is_solved()) {
+      if (m_slope_angle_eqn.second->reduce_if_solvable()) {
         set_proved(PROVED_AR_ANGLE);
         return;
       }
     }
+    m_solver->watch_reduced_equations(this);
+  }
+
+  void StatementProof::notify_watchers() const {
+    m_solver->wake_theorems(this);
   }
 
   void StatementProof::set_theorem(size_t ind) {
@@ -166,6 +167,7 @@ namespace Yuclid {
 
     m_state = state;
     m_solver->push_established_statement(this);
+    notify_watchers();
 
     if (!m_statement->check_numerically()) {
       BOOST_LOG_TRIVIAL(error) << "Established a numerically incorrect statement " << *this;
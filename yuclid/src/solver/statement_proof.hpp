@@ -116,6 +116,19 @@ namespace Yuclid {
 
     const std::vector<size_t> &theorems_that_imply() const { return m_theorems_that_imply; }
 
+    void register_as_hypothesis(size_t i) { m_theorems_that_assume.push_back(i); }
+
+    const std::vector<size_t> &theorems_that_assume() const { return m_theorems_that_assume; }
+
+    /**
+     * @brief Tell the solver that the state of this proof may have changed.
+     *
+     * Called when the statement is proved,
+     * and by the AR tables when one of the reduced equations
+     * can be reduced further.
+     */
+    void notify_watchers() const;
+
     const DDARSolver *get_solver() const { return m_solver; }
 
     template <typename VarT>
@@ -145,6 +158,7 @@ namespace Yuclid {
     std::unique_ptr<Statement> m_statement;
     std::optional<size_t> m_theorem;
     std::vector<size_t> m_theorems_that_imply;
+    std::vector<size_t> m_theorems_that_assume;
     std::pair<Rat, ReducedEquation<Dist>*> m_dist_eqn;
     std::pair<Rat, ReducedEquation<SquaredDist>*> m_squared_dist_eqn;
     std::pair<Rat, ReducedEquation<SinOrDist>*> m_sin_or_dist_eqn;
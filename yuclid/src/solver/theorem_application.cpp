@@ -31,6 +31,9 @@ namespace Yuclid {
     for (const auto &p : m_theorem.conclusions()) {
       m_conclusions.push_back(solver->insert_statement(p));
     }
+    for (auto *p : m_hypotheses) {
+      p->register_as_hypothesis(k);
+    }
     for (auto *p : m_conclusions) {
       p->register_as_conclusion(k);
     }
@@ -53,17 +56,22 @@ namespace Yuclid {
       return;
     }
 
-    bool hypotheses_proved = true;
-    for (auto *pf : m_hypotheses) {
+    // Hypotheses before `m_next_hypothesis` are already proved.
+    for (; m_next_hypothesis < m_hypotheses.size(); ++ m_next_hypothesis) {
+      auto *pf = m_hypotheses[m_next_hypothesis];
       pf->make_progress();
       if (!pf->is_proved()) {
-        hypotheses_proved = false;
-        break;
+        return;
       }
     }
-    if (hypotheses_proved) {
-      m_state = TheoremApplicationState::PROVED;
+    m_state = TheoremApplicationState::PROVED;
+  }
+
+  const StatementProof *TheoremApplication::waiting_for() const {
+    if (m_next_hypothesis < m_hypotheses.size()) {
+      return m_hypotheses[m_next_hypothesis];
     }
+    return nullptr;
   }
 
   std::ostream &operator<<(std::ostream &out, const TheoremApplicationState &st) {
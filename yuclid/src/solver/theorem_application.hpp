@@ -65,6 +65,14 @@ namespace Yuclid {
 
     [[nodiscard]] const Point &get_max_point() const { return m_max_point; }
 
+    /**
+     * @brief The first hypothesis that isn't proved yet.
+     *
+     * Updated by `advance_proof()`.
+     * Returns `nullptr` if all hypotheses are proved.
+     */
+    [[nodiscard]] const StatementProof *waiting_for() const;
+
   private:
     /** The theorem we're trying to apply. */
     Theorem m_theorem;
@@ -76,6 +84,8 @@ namespace Yuclid {
     std::vector<StatementProof *> m_conclusions;
     /** Maximal point used in the theorem. */
     Point m_max_point;
+    /** Index of the first hypothesis that wasn't proved on the last attempt. */
+    size_t m_next_hypothesis{0};
   };
 
   std::ostream &operator<<(std::ostream &out, const TheoremApplicationState &st);
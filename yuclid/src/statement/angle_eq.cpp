@@ -63,6 +63,10 @@ namespace Yuclid {
     return {m_angle, m_rhs};
   }
 
+  void AngleEq::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::ACONST_ANGLE, m_angle, m_rhs);
+  }
+
   std::optional<Equation<SlopeAngle>> AngleEq::as_equation_slope_angle() const {
     return Equation<SlopeAngle>::sub_eq_const(m_angle.right_side(), m_angle.left_side(), m_rhs);
   }
@@ -75,6 +75,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
 
     [[nodiscard]] LineAngleEq to_line_angle_eq() const;
 
@@ -75,6 +75,10 @@ namespace Yuclid {
     return {m_center, m_triangle};
   }
 
+  void Circumcenter::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::CIRCUMCENTER, m_center, m_triangle);
+  }
+
   unique_ptr<Statement> Circumcenter::clone() const {
     return make_unique<Circumcenter>(*this); // Implementation of clone()
   }
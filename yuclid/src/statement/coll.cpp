@@ -82,6 +82,10 @@ namespace Yuclid {
     return {m_a, m_b, m_c}; // Using new member names
   }
 
+  void Collinear::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::COLL, m_a, m_b, m_c);
+  }
+
   EqualRatios Collinear::eqratio_ab_bc(const Collinear &other) const {
     return
       { Dist(m_a, m_b), Dist(m_b, m_c),
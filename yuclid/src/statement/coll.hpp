@@ -37,6 +37,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
 
     [[nodiscard]] std::array<Collinear, 3> cyclic_permutations() const;
     [[nodiscard]] std::array<Collinear, 6> permutations() const;
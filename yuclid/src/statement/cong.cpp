@@ -82,6 +82,10 @@ namespace Yuclid {
     };
   }
 
+  void DistEqDist::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::CONG, m_left, m_right);
+  }
+
   bool DistEqDist::is_refl() const {
     return m_left == m_right;
   }
@@ -35,6 +35,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
 
     // Public read-only access methods
     [[nodiscard]] const Dist& left() const { return m_left; }
@@ -59,6 +59,10 @@ namespace Yuclid {
     return make_unique<CongruentTriangles>(*this);
   }
 
+  void CongruentTriangles::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::CONGRUENT_TRIANGLES, left(), right(), same_clockwise());
+  }
+
   DistEqDist CongruentTriangles::cong_ab() const {
     return {left().dist_ab(), right().dist_ab()};
   }
@@ -34,6 +34,7 @@ namespace Yuclid {
     [[nodiscard]] std::unique_ptr<Statement> normalize() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::unique_ptr<Statement> clone() const override; // Added clone() declaration
+    void pack(StatementKey::Words &words) const override;
 
     [[nodiscard]] DistEqDist cong_ab() const;
     [[nodiscard]] DistEqDist cong_bc() const;
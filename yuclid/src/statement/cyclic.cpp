@@ -67,6 +67,10 @@ namespace Yuclid {
     return {m_a, m_b, m_c, m_d};
   }
 
+  void CyclicQuadrangle::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::CYCLIC, m_a, m_b, m_c, m_d);
+  }
+
   unique_ptr<Statement> CyclicQuadrangle::clone() const {
     return make_unique<CyclicQuadrangle>(*this);
   }
@@ -38,6 +38,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     [[nodiscard]] std::unique_ptr<Statement> clone() const override;
 
     // Public read-only access methods for points
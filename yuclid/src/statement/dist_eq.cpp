@@ -84,6 +84,10 @@ namespace Yuclid {
     };
   }
 
+  void DistEq::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::LCONST, m_dist, m_rhs);
+  }
+
   boost::json::object DistEq::to_json() const {
     std::vector<string> args = {
       m_dist.left().name(),
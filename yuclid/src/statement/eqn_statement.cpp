@@ -171,6 +171,29 @@ namespace Yuclid {
     return result_args;
   }
 
+  template<typename VarT>
+  void EqnStatement<VarT>::pack(StatementKey::Words &words) const {
+    Predicate pred{};
+    if constexpr (std::is_same_v<VarT, Dist>) {
+      pred = Predicate::EQUATION_DIST;
+    } else if constexpr (std::is_same_v<VarT, SquaredDist>) {
+      pred = Predicate::EQUATION_SQUARED_DIST;
+    } else if constexpr (std::is_same_v<VarT, SinOrDist>) {
+      pred = Predicate::EQUATION_SIN_OR_DIST;
+    } else if constexpr (std::is_same_v<VarT, Angle>) {
+      pred = Predicate::EQUATION_ANGLE;
+    } else {
+      static_assert(false, "Type is unsupported");
+    }
+    const auto &terms = m_eqn.lhs().terms();
+    StatementKey::pack(words, pred);
+    words.push_back(terms.size());
+    for (const auto &[var, coeff] : terms) {
+      StatementKey::pack_args(words, coeff, var);
+    }
+    StatementKey::pack_arg(words, m_eqn.rhs());
+  }
+
   template<typename VarT>
   unique_ptr<Statement> EqnStatement<VarT>::clone() const {
     return make_unique<EqnStatement<VarT>>(*this); // Implementation of clone()
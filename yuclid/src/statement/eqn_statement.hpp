@@ -42,6 +42,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_equations() const override;
 
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     [[nodiscard]] std::unique_ptr<Statement> clone() const override; // Added clone() declaration
 
     // Public read-only access method
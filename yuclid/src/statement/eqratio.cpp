@@ -117,6 +117,10 @@ namespace Yuclid {
     };
   }
 
+  void EqualRatios::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::EQRATIO, m_num_left, m_den_left, m_num_right, m_den_right);
+  }
+
   std::ostream &EqualRatios::print(std::ostream &out) const {
     out << m_num_left << ":" << m_den_left << " = " << m_num_right << ":" << m_den_right;
     return out;
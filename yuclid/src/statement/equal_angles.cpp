@@ -71,6 +71,10 @@ namespace Yuclid {
     return {m_left, m_right};
   }
 
+  void EqualAngles::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::EQUAL_ANGLES, m_left, m_right);
+  }
+
   std::optional<Equation<SlopeAngle>> EqualAngles::as_equation_slope_angle() const {
     return to_equal_line_angles().as_equation<SlopeAngle>();
   }
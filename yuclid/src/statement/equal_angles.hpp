@@ -34,6 +34,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     [[nodiscard]] std::array<EqualAngles, 4> permutations() const;
 
     // Public read-only access methods
@@ -74,6 +74,10 @@ namespace Yuclid {
     return {m_left_left, m_left_right, m_right_left, m_right_right};
   }
 
+  void EqualLineAngles::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::EQANGLE, m_left_left, m_left_right, m_right_left, m_right_right);
+  }
+
   bool EqualLineAngles::is_refl() const {
     return m_left_left == m_right_left && m_left_right == m_right_right;
   }
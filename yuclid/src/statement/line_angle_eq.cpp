@@ -83,6 +83,10 @@ namespace Yuclid {
     return {m_left, m_right, m_rhs};
   }
 
+  void LineAngleEq::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::ACONST_LINES, m_left, m_right, m_rhs);
+  }
+
   std::optional<Equation<SlopeAngle>> LineAngleEq::as_equation_slope_angle() const {
     return Equation<SlopeAngle>::sub_eq_const(m_right, m_left, m_rhs);
   }
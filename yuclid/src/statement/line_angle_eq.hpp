@@ -36,6 +36,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
 
     // Public read-only access methods
     [[nodiscard]] const SlopeAngle &left() const { return m_left; }
@@ -89,6 +89,10 @@ namespace Yuclid {
     return to_coll().args();
   }
 
+  void Midpoint::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::MIDPOINT, m_left, m_middle, m_right);
+  }
+
   unique_ptr<Statement> Midpoint::clone() const {
     return make_unique<Midpoint>(m_left, m_middle, m_right);
   }
@@ -52,6 +52,10 @@ namespace Yuclid {
     return {m_a, m_b, m_c}; // Using new member names
   }
 
+  void NonCollinear::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::NCOLL, m_a, m_b, m_c);
+  }
+
   std::ostream &NonCollinear::print(std::ostream &out) const {
     return out << m_a << " ∉ " << m_b << m_c;
   }
@@ -49,6 +49,10 @@ namespace Yuclid {
     return {m_left, m_right};
   }
 
+  void NotEqual::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::DIFF, m_left, m_right);
+  }
+
   std::ostream &NotEqual::print(std::ostream &out) const {
     return out << m_left << " ≠ " << m_right;
   }
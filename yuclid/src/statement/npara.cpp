@@ -49,6 +49,10 @@ namespace Yuclid {
 
   vector<statement_arg> NonParallel::args() const { return {m_left, m_right}; }
 
+  void NonParallel::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::NPARA, m_left, m_right);
+  }
+
   ostream &NonParallel::print(ostream &out) const {
     return out << m_left.left() << m_left.right() << "∦" << m_right.left() << m_right.right();
   }
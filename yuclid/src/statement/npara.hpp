@@ -32,6 +32,7 @@ namespace Yuclid {
     [[nodiscard]] std::unique_ptr<Statement> normalize() const override;
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     [[nodiscard]] bool check_equations() const override { return true; }
     [[nodiscard]] bool numerical_only() const override { return true; }
 
@@ -49,6 +49,10 @@ namespace Yuclid {
 
   vector<statement_arg> NonPerpendicular::args() const { return {m_left, m_right}; }
 
+  void NonPerpendicular::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::NPERP, m_left, m_right);
+  }
+
   ostream &NonPerpendicular::print(ostream &out) const {
     return out << m_left.left() << m_left.right() << "⟂̸" << m_right.left() << m_right.right();
   }
@@ -66,6 +66,10 @@ namespace Yuclid {
     return {m_angle};
   }
 
+  void ObtuseAngle::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::OBTUSE_ANGLE, m_angle);
+  }
+
   unique_ptr<Statement> ObtuseAngle::clone() const {
     return make_unique<ObtuseAngle>(m_angle);
   }
@@ -48,6 +48,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] bool numerical_only() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     [[nodiscard]] std::unique_ptr<Statement> clone() const override;
 
     [[nodiscard]] const Angle &angle() const { return m_angle; }
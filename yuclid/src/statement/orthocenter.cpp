@@ -57,6 +57,10 @@ namespace Yuclid {
     return {m_triangle, m_orthocenter};
   }
 
+  void IsOrthocenter::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::IS_ORTHOCENTER, m_triangle, m_orthocenter);
+  }
+
   Perpendicular IsOrthocenter::perp_a() const {
     return {SlopeAngle(m_triangle.a(), m_orthocenter),
                 SlopeAngle(m_triangle.b(), m_triangle.c())};
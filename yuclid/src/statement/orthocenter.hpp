@@ -42,6 +42,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_nondegen() const override;
     [[nodiscard]] bool check_equations() const override;
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     auto operator<=>(const IsOrthocenter &other) const = default;
 
     [[nodiscard]] Perpendicular perp_a() const;
@@ -65,6 +65,10 @@ namespace Yuclid {
     return {m_left, m_right};
   }
 
+  void Parallel::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::PARA, m_left, m_right);
+  }
+
   ostream &Parallel::print(ostream &out) const {
     return out << m_left.left() << m_left.right() << " ∥ " << m_right.left() << m_right.right();
   }
@@ -83,6 +83,10 @@ namespace Yuclid {
     return {m_a, m_b, m_c, m_d};
   }
 
+  void Parallelogram::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::PARALLELOGRAM, m_a, m_b, m_c, m_d);
+  }
+
   Parallel Parallelogram::para_ab_cd() const {
     return {SlopeAngle(m_a, m_b), SlopeAngle(m_c, m_d)};
   }
@@ -41,6 +41,7 @@ namespace Yuclid {
     [[nodiscard]] bool check_equations() const override;
 
     [[nodiscard]] std::vector<statement_arg> args() const override;
+    void pack(StatementKey::Words &words) const override;
     auto operator<=>(const Parallelogram &other) const = default;
 
     [[nodiscard]] Parallel para_ab_cd() const;
@@ -67,6 +67,10 @@ namespace Yuclid {
     return {m_left, m_right};
   }
 
+  void Perpendicular::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::PERP, m_left, m_right);
+  }
+
   Perpendicular Perpendicular::swap() const {
     return {m_right, m_left};
   }
@@ -99,6 +99,10 @@ namespace Yuclid {
     };
   }
 
+  void RatioDistEquals::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::RCONST, m_left, m_right, m_ratio);
+  }
+
   optional<RatioSquaredDist> RatioDistEquals::as_ratio_squared_dist() const {
     return RatioSquaredDist(SquaredDist(m_left), SquaredDist(m_right), m_ratio * m_ratio);
   }
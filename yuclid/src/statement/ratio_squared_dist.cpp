@@ -103,6 +103,10 @@ namespace Yuclid {
     };
   }
 
+  void RatioSquaredDist::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::RATIO_SQUARED_DIST, m_left, m_right, m_ratio);
+  }
+
   boost::json::object RatioSquaredDist::to_json() const {
     vector<string> args =
       {m_left.left().name(), m_left.right().name(),
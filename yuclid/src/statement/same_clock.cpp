@@ -55,6 +55,10 @@ namespace Yuclid {
     return {m_left, m_right};
   }
 
+  void SameClock::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::SAMECLOCK, m_left, m_right);
+  }
+
   std::ostream &SameClock::print(std::ostream &out) const {
     return out << m_left << " oriented the same way as " << m_right;
   }
@@ -69,6 +69,10 @@ namespace Yuclid {
     return {m_a, m_b, m_c, m_d, m_e, m_f};
   }
 
+  void SameSignDot::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::SAMESIDE, m_a, m_b, m_c, m_d, m_e, m_f);
+  }
+
   std::unique_ptr<Statement> SameSignDot::clone() const {
     return make_unique<SameSignDot>(*this);
   }
@@ -143,6 +143,10 @@ namespace Yuclid {
     return {m_left, m_right, m_same_clockwise};
   }
 
+  void SimilarTriangles::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::SIMILAR_TRIANGLES, m_left, m_right, m_same_clockwise);
+  }
+
   unique_ptr<Statement> SimilarTriangles::clone() const {
     return make_unique<SimilarTriangles>(*this); // Implementation of clone()
   }
@@ -96,4 +96,8 @@ namespace Yuclid {
     };
   }
 
+  void SquaredDistEq::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::SQUARED_DIST_EQ, m_squared_dist, m_rhs);
+  }
+
 } // namespace Yuclid
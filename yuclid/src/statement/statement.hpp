@@ -19,6 +19,7 @@
 #include <vector>
 #include <optional>
 #include "ar/equation.hpp"
+#include "statement/statement_key.hpp"
 #include "typedef.hpp"
 #include "type/triangle.hpp"
 
@@ -89,6 +90,13 @@ namespace Yuclid {
      */
     [[nodiscard]] virtual std::vector<statement_arg> args() const = 0;
 
+    /** Append the predicate and the arguments of this statement to `words`, see `StatementKey`.
+
+        The words must determine `data()`.
+        Implementations write their members directly instead of building `args()`.
+     */
+    virtual void pack(StatementKey::Words &words) const = 0;
+
     [[nodiscard]] virtual StatementData data() const final {
       return {.name=this->name(), .args=this->args()};
     }
@@ -0,0 +1,132 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "statement/statement_key.hpp"
+
+#include "numbers/add_circle.hpp"
+#include "numbers/root_rat.hpp"
+#include "statement/statement.hpp"
+#include "type/angle.hpp"
+#include "type/dist.hpp"
+#include "type/point.hpp"
+#include "type/sin_or_dist.hpp"
+#include "type/slope_angle.hpp"
+#include "type/squared_dist.hpp"
+#include "type/triangle.hpp"
+#include "typedef.hpp"
+#include <bit>
+#include <boost/container_hash/hash.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cstdint>
+#include <iterator>
+
+using namespace std;
+
+namespace Yuclid {
+
+  namespace {
+    using Words = StatementKey::Words;
+
+    /**
+     * @brief Pack an integer.
+     *
+     * With `WITH_BIG_INTEGERS`, a big value is packed as its sign,
+     * the number of 64-bit words of its magnitude and these words.
+     */
+    template <typename IntT, typename SmallT>
+    void pack_integer(Words &words, const IntT &val) {
+#ifdef WITH_BIG_INTEGERS
+      if (val.is_small()) {
+        words.push_back(0);
+        words.push_back(bit_cast<uint64_t>(val.small()));
+      } else {
+        words.push_back(val.big().sign() < 0 ? 2 : 1);
+        const size_t size_at = words.size();
+        words.push_back(0);
+        boost::multiprecision::export_bits(val.big(), back_inserter(words), 64);
+        words[size_at] = words.size() - size_at - 1;
+      }
+#else
+      words.push_back(bit_cast<uint64_t>(static_cast<SmallT>(val)));
+#endif
+    }
+
+    template <typename IntT, typename SmallT>
+    void pack_rational(Words &words, const boost::rational<IntT> &val) {
+      pack_integer<IntT, SmallT>(words, val.numerator());
+      pack_integer<IntT, SmallT>(words, val.denominator());
+    }
+  }
+
+  StatementKey::StatementKey(const Statement &stmt) {
+    stmt.pack(m_words);
+    m_hash = boost::hash_range(m_words.begin(), m_words.end());
+  }
+
+  void StatementKey::pack_arg(Words &words, const AddCircle<Rat> &val) {
+    pack_rational<Int, UnsafeInt>(words, val.number());
+  }
+
+  void StatementKey::pack_arg(Words &words, const Angle &val) {
+    pack_args(words, val.left(), val.vertex(), val.right());
+  }
+
+  void StatementKey::pack_arg(Words &words, const Dist &val) {
+    pack_args(words, val.left(), val.right());
+  }
+
+  void StatementKey::pack_arg(Words &words, const NNRat &val) {
+    pack_rational<Nat, UnsafeNat>(words, val);
+  }
+
+  void StatementKey::pack_arg(Words &words, const Point &val) {
+    words.push_back(val.get());
+  }
+
+  void StatementKey::pack_arg(Words &words, const Rat &val) {
+    pack_rational<Int, UnsafeInt>(words, val);
+  }
+
+  void StatementKey::pack_arg(Words &words, const RootRat &val) {
+    words.push_back(static_cast<uint64_t>(distance(val.data().begin(), val.data().end())));
+    for (const auto &[prime, power] : val.data()) {
+      words.push_back(prime);
+      pack_rational<Int, UnsafeInt>(words, power);
+    }
+  }
+
+  void StatementKey::pack_arg(Words &words, const SinOrDist &val) {
+    if (val.is_sin()) {
+      words.push_back(0);
+      pack_arg(words, val.angle());
+    } else {
+      words.push_back(1);
+      pack_arg(words, val.get_squared_dist());
+    }
+  }
+
+  void StatementKey::pack_arg(Words &words, const SlopeAngle &val) {
+    pack_args(words, val.left(), val.right());
+  }
+
+  void StatementKey::pack_arg(Words &words, const SquaredDist &val) {
+    pack_args(words, val.left(), val.right());
+  }
+
+  void StatementKey::pack_arg(Words &words, const Triangle &val) {
+    pack_args(words, val.a(), val.b(), val.c());
+  }
+
+}
@@ -0,0 +1,139 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "typedef.hpp"
+#include <boost/container/small_vector.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace Yuclid {
+  class Statement;
+
+  /**
+   * @brief The kind of a statement, the first word of its `StatementKey`.
+   *
+   * There is one predicate per class of statements,
+   * so statements of different classes never get equal keys,
+   * even if their names are equal, e.g., `AngleEq` and `LineAngleEq`.
+   */
+  enum class Predicate : uint8_t {
+    ACONST_ANGLE,
+    ACONST_LINES,
+    CIRCUMCENTER,
+    COLL,
+    CONG,
+    CONGRUENT_TRIANGLES,
+    CYCLIC,
+    DIFF,
+    EQANGLE,
+    EQRATIO,
+    EQUAL_ANGLES,
+    EQUATION_ANGLE,
+    EQUATION_DIST,
+    EQUATION_SIN_OR_DIST,
+    EQUATION_SQUARED_DIST,
+    IS_ORTHOCENTER,
+    LCONST,
+    MIDPOINT,
+    NCOLL,
+    NPARA,
+    NPERP,
+    NSAMESIDE,
+    OBTUSE_ANGLE,
+    PARA,
+    PARALLELOGRAM,
+    PERP,
+    RATIO_SQUARED_DIST,
+    RCONST,
+    SAMECLOCK,
+    SAMESIDE,
+    SIMILAR_TRIANGLES,
+    SQUARED_DIST_EQ,
+    THALES,
+  };
+
+  /**
+   * @brief A compact key that uniquely identifies a statement.
+   *
+   * Unlike `StatementData`, the key packs the predicate and the arguments
+   * of the statement into a flat sequence of 64-bit words:
+   * points are stored as their indices, rational numbers as pairs of integers etc.
+   * Each statement writes its own words in `Statement::pack`,
+   * so building a key neither formats the name nor builds `Statement::args()`.
+   * Most keys fit into the inline buffer, so building a key doesn't allocate,
+   * and comparing two keys is a comparison of two short arrays of integers.
+   *
+   * The hash is computed once, in the constructor.
+   */
+  class StatementKey {
+  public:
+    using Words = boost::container::small_vector<uint64_t, 12>;
+
+    /**
+     * @brief Pack the predicate and the arguments of `stmt`.
+     *
+     * Two statements get equal keys iff their `Statement::data()` are equal.
+     */
+    explicit StatementKey(const Statement &stmt);
+
+    [[nodiscard]] const Words &words() const { return m_words; }
+
+    bool operator==(const StatementKey &other) const = default;
+
+    friend size_t hash_value(const StatementKey &key) { return key.m_hash; }
+
+    /**
+     * @brief Append `pred` and `args` to `words`.
+     *
+     * The arguments of a given predicate must always have the same types,
+     * arguments of variable length are prefixed by their length.
+     */
+    template <typename... Args>
+    static void pack(Words &words, Predicate pred, const Args &...args) {
+      words.push_back(static_cast<uint64_t>(pred));
+      pack_args(words, args...);
+    }
+
+    /** @brief Append `args` to `words`. */
+    template <typename... Args>
+    static void pack_args(Words &words, const Args &...args) {
+      (pack_arg(words, args), ...);
+    }
+
+    static void pack_arg(Words &words, const AddCircle<Rat> &val);
+    static void pack_arg(Words &words, const Angle &val);
+    static void pack_arg(Words &words, const Dist &val);
+    static void pack_arg(Words &words, const NNRat &val);
+    static void pack_arg(Words &words, const Point &val);
+    static void pack_arg(Words &words, const Rat &val);
+    static void pack_arg(Words &words, const RootRat &val);
+    static void pack_arg(Words &words, const SinOrDist &val);
+    static void pack_arg(Words &words, const SlopeAngle &val);
+    static void pack_arg(Words &words, const SquaredDist &val);
+    static void pack_arg(Words &words, const Triangle &val);
+
+    /** @brief Only `bool` itself, so that other values don't convert to it silently. */
+    template <std::same_as<bool> BoolT>
+    static void pack_arg(Words &words, BoolT val) {
+      words.push_back(val ? 1 : 0);
+    }
+
+  private:
+    size_t m_hash{0};
+    Words m_words;
+  };
+}
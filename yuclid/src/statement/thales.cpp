@@ -97,6 +97,10 @@ namespace Yuclid {
     return {m_left.a(), m_left.b(), m_left.c(), m_right.a(), m_right.b(), m_right.c()};
   }
 
+  void Thales::pack(StatementKey::Words &words) const {
+    StatementKey::pack(words, Predicate::THALES, m_left.a(), m_left.b(), m_left.c(), m_right.a(), m_right.b(), m_right.c());
+  }
+
   unique_ptr<Statement> Thales::clone() const {
     return make_unique<Thales>(*this);
   }
@@ -48,6 +48,7 @@
 #include "type/slope_angle.hpp"
 #include "type/squared_dist.hpp"
 #include "typedef.hpp"
+#include "verdict_cache.hpp"
 #include <algorithm>
 #include <boost/json/conversion.hpp>
 #include <boost/json/value.hpp>
@@ -89,6 +90,18 @@ namespace Yuclid {
     return check_hypotheses_numerically() && check_conclusions_numerically();
   }
 
+  bool Theorem::check_hypotheses_numerically(VerdictCache &cache) const {
+    return ranges::all_of(hypotheses(), [&cache](const auto &p) { return cache.check_numerically(*p); });
+  }
+
+  bool Theorem::check_conclusions_numerically(VerdictCache &cache) const {
+    return ranges::all_of(conclusions(), [&cache](const auto &p) { return cache.check_numerically(*p); });
+  }
+
+  bool Theorem::check_numerically(VerdictCache &cache) const {
+    return check_hypotheses_numerically(cache) && check_conclusions_numerically(cache);
+  }
+
   Theorem& Theorem::add_similar_triangles_hypotheses(const SimilarTriangles& p) {
     return add_hypothesis<SameClock>(p.to_same_clock());
   }
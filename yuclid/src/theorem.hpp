@@ -44,6 +44,7 @@ namespace Yuclid {
   class Perpendicular;
   class SimilarTriangles;
   class Thales;
+  class VerdictCache;
 
   class Theorem {
   public:
@@ -67,6 +68,15 @@ namespace Yuclid {
     /** Check if both hypotheses and conclusions are numerically correct. */
     [[nodiscard]] bool check_numerically() const;
 
+    /** Same as `check_hypotheses_numerically()`, but look up the verdicts in `cache` first. */
+    [[nodiscard]] bool check_hypotheses_numerically(VerdictCache &cache) const;
+
+    /** Same as `check_conclusions_numerically()`, but look up the verdicts in `cache` first. */
+    [[nodiscard]] bool check_conclusions_numerically(VerdictCache &cache) const;
+
+    /** Same as `check_numerically()`, but look up the verdicts in `cache` first. */
+    [[nodiscard]] bool check_numerically(VerdictCache &cache) const;
+
     static Theorem equal_angles_of_cong(const Point& vertex, const Point& left, const Point& right);
 
     static Theorem cong_of_equal_angles(const Point& vertex, const Point& left, const Point& right);
@@ -0,0 +1,55 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "theorem_key.hpp"
+
+#include "statement/statement.hpp"
+#include "statement/statement_key.hpp"
+#include "theorem.hpp"
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  namespace {
+    /** Most theorems fit, so building a key allocates once. */
+    using Scratch = boost::container::small_vector<uint64_t, 64>;
+
+    void pack(Scratch &words, const vector<unique_ptr<Statement>> &stmts) {
+      words.push_back(stmts.size());
+      for (const auto &stmt : stmts) {
+        StatementKey const key(*stmt);
+        words.push_back(key.words().size());
+        words.insert(words.end(), key.words().begin(), key.words().end());
+      }
+    }
+  }
+
+  TheoremKey::TheoremKey(const Theorem &thm) : m_name(thm.name()) {
+    Scratch words;
+    pack(words, thm.hypotheses());
+    pack(words, thm.conclusions());
+    m_words.assign(words.begin(), words.end());
+    m_hash = boost::hash_value(m_name);
+    boost::hash_range(m_hash, m_words.begin(), m_words.end());
+  }
+
+}
@@ -0,0 +1,53 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Yuclid {
+  class Theorem;
+
+  /**
+   * @brief A compact key that uniquely identifies a theorem.
+   *
+   * The key consists of the name of the rule
+   * and the `StatementKey`s of the hypotheses and the conclusions,
+   * packed into one flat sequence of 64-bit words.
+   * Two theorems get equal keys iff they apply the same rule
+   * to the same lists of statements,
+   * so the key should be built from a normalized theorem.
+   *
+   * The hash is computed once, in the constructor.
+   */
+  class TheoremKey {
+  public:
+    explicit TheoremKey(const Theorem &thm);
+
+    /** @brief The name of the rule, see `Theorem::name()`. */
+    [[nodiscard]] std::string_view name() const { return m_name; }
+
+    bool operator==(const TheoremKey &other) const = default;
+
+    friend size_t hash_value(const TheoremKey &key) { return key.m_hash; }
+
+  private:
+    std::string_view m_name;
+    size_t m_hash{0};
+    std::vector<uint64_t> m_words;
+  };
+}
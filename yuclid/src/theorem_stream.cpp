@@ -0,0 +1,110 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "theorem_stream.hpp"
+#include "theorem.hpp"
+#include "theorem_key.hpp"
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace Yuclid {
+
+  TheoremStream::TheoremStream(const TheoremSink &sink, map<string_view, RuleStats> &rule_stats,
+                               size_t num_groups, size_t flush_size) :
+    m_sink(sink), m_rule_stats(rule_stats), m_flush_size(flush_size),
+    m_groups(num_groups), m_opened(num_groups, false) {}
+
+  void TheoremStream::open(size_t group, size_t num_parts) {
+    lock_guard const lock(m_mutex);
+    assert(!m_opened[group]);
+    vector<Part> parts(num_parts);
+    for (size_t ind = 0; ind < num_parts; ++ ind) {
+      parts[ind].stream = this;
+      parts[ind].group = group;
+      parts[ind].index = ind;
+    }
+    m_groups[group] = std::move(parts);
+    m_opened[group] = true;
+    advance();
+  }
+
+  bool TheoremStream::insert(Part &part, Theorem &&thm) {
+    TheoremKey key(thm);
+    if (!part.seen.insert(key).second) {
+      return false;
+    }
+    part.theorems.push_back(std::move(thm));
+    part.keys.push_back(std::move(key));
+    if (part.theorems.size() >= m_flush_size) {
+      lock_guard const lock(m_mutex);
+      if (m_group == part.group && m_part == part.index) {
+        pass(part);
+      }
+    }
+    return true;
+  }
+
+  void TheoremStream::finish(Part &part) {
+    lock_guard const lock(m_mutex);
+    part.finished = true;
+    advance();
+  }
+
+  void TheoremStream::pass(Part &part) {
+    for (size_t ind = 0; ind < part.theorems.size(); ++ ind) {
+      RuleStats &stats = m_rule_stats[part.keys[ind].name()];
+      if (m_passed.insert(std::move(part.keys[ind])).second) {
+        ++ stats.matched;
+        m_sink(std::move(part.theorems[ind]));
+      } else {
+        ++ stats.duplicates;
+      }
+    }
+    part.theorems.clear();
+    part.keys.clear();
+  }
+
+  void TheoremStream::advance() {
+    while (m_group < m_groups.size() && m_opened[m_group]) {
+      auto &parts = m_groups[m_group];
+      for (; m_part < parts.size(); ++ m_part) {
+        if (!parts[m_part].finished) {
+          return;
+        }
+        Part &part = parts[m_part];
+        pass(part);
+        part.theorems.shrink_to_fit();
+        part.keys.shrink_to_fit();
+        for (const auto &[name, stats] : part.rule_stats) {
+          RuleStats &total = m_rule_stats[name];
+          total.candidates += stats.candidates;
+          total.duplicates += stats.duplicates;
+        }
+        part.rule_stats = {};
+        part.seen = {};
+      }
+      ++ m_group;
+      m_part = 0;
+    }
+  }
+
+}
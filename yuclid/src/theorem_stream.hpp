@@ -0,0 +1,131 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "theorem.hpp"
+#include "theorem_key.hpp"
+
+namespace Yuclid {
+  /**
+   * @brief Receives normalized matched theorems, e.g., a solver or a printer.
+   *
+   * The matcher never calls a sink concurrently.
+   */
+  using TheoremSink = std::function<void(Theorem &&)>;
+
+  /** @brief Counts of the theorems matched by one rule. */
+  struct RuleStats {
+    /** Theorems generated by the matcher, including the numerically false ones. */
+    size_t candidates{0};
+    /** Numerically true theorems dropped because an equal normalized theorem was matched before. */
+    size_t duplicates{0};
+    /** Theorems passed to the sink. */
+    size_t matched{0};
+  };
+
+  /**
+   * @brief Theorems matched by parallel tasks, passed to a sink in a fixed order.
+   *
+   * The order is given by groups of parts, and each task writes to its own part.
+   * A group can be opened (i.e., split into parts) later than the groups before it,
+   * e.g., when the number of its tasks is known only in a later stage.
+   * The groups that follow it wait until then,
+   * so the groups should be ordered by the stage that opens them.
+   *
+   * A finished part is passed to the sink and freed
+   * as soon as all parts before it are passed.
+   * The first part that isn't finished yet passes its theorems
+   * every time it collects `flush_size()` of them,
+   * so the task that is first in the order doesn't hold more than that.
+   * The sink is called under a lock, so it's never called concurrently.
+   *
+   * Each part drops the duplicates of its own theorems;
+   * the stream drops the duplicates of theorems from different parts,
+   * keeping the first one in the order.
+   * For this, it keeps the keys of all theorems passed to the sink.
+   */
+  class TheoremStream {
+  public:
+    static constexpr size_t default_flush_size = 1024;
+
+    struct Part {
+      TheoremStream *stream{nullptr};
+      size_t group{0};
+      size_t index{0};
+      std::vector<Theorem> theorems;
+      /** Keys of `theorems`. */
+      std::vector<TheoremKey> keys;
+      /** Keys of the theorems inserted to this part. */
+      boost::unordered_flat_set<TheoremKey, boost::hash<TheoremKey>> seen;
+      boost::unordered_flat_map<std::string_view, RuleStats> rule_stats;
+      bool finished{false};
+    };
+
+    TheoremStream(const TheoremSink &sink, std::map<std::string_view, RuleStats> &rule_stats,
+                  size_t num_groups, size_t flush_size = default_flush_size);
+
+    /** @brief Split `group` into `num_parts` parts. Must be called once per group. */
+    void open(size_t group, size_t num_parts);
+
+    [[nodiscard]] Part &part(size_t group, size_t ind) { return m_groups[group][ind]; }
+
+    /**
+     * @brief Append a numerically true normalized theorem to `part`.
+     *
+     * Passes the theorems of `part` to the sink
+     * if it has `flush_size()` of them and it's the first part that isn't passed yet.
+     *
+     * @return false if `part` already had this theorem, so it was dropped.
+     */
+    bool insert(Part &part, Theorem &&thm);
+
+    /** @brief Mark `part` as finished; no more theorems can be added to it. */
+    void finish(Part &part);
+
+    /** @brief Whether all theorems were passed to the sink. */
+    [[nodiscard]] bool done() const { return m_group == m_groups.size(); }
+
+    [[nodiscard]] size_t flush_size() const { return m_flush_size; }
+
+  private:
+    /** @brief Pass the theorems of `part` to the sink, dropping the duplicates of passed ones. */
+    void pass(Part &part);
+
+    /** @brief Pass all finished parts that follow the parts passed before. */
+    void advance();
+
+    const TheoremSink &m_sink;
+    std::map<std::string_view, RuleStats> &m_rule_stats;
+    size_t m_flush_size;
+    /** Keys of the theorems passed to the sink. */
+    boost::unordered_flat_set<TheoremKey, boost::hash<TheoremKey>> m_passed;
+    std::mutex m_mutex;
+    std::vector<std::vector<Part>> m_groups;
+    std::vector<bool> m_opened;
+    /** The first part that wasn't passed yet. */
+    size_t m_group{0};
+    size_t m_part{0};
+  };
+}
@@ -17,8 +17,8 @@
 #include "squared_dist.hpp" // Needed for explicit conversion to squared_dist
 #include "sin_or_dist.hpp"
 #include "type/point.hpp"
+#include "problem.hpp"
 #include <algorithm> // For std::min and std::max
-#include <cmath>     // For std::sqrt
 #include <cstddef>
 #include <ostream>
 #include <boost/container_hash/hash.hpp>
@@ -35,9 +35,7 @@ namespace Yuclid {
   }
 
   Dist::operator double() const {
-    // Create a temporary squared_dist object to get the squared value, then take its square root.
-    // This implicitly uses the operator double() of squared_dist.
-    return sqrt(static_cast<double>(SquaredDist(*this)));
+    return m_left.problem()->geometry().dist(m_left.get(), m_right.get());
   }
 
   Dist::operator SquaredDist() const {
@@ -27,15 +27,15 @@ using namespace std;
 namespace Yuclid {
 
   double Point::x() const {
-    return m_problem->get_x(*this);
+    return problem()->geometry().x(m_data);
   }
 
   double Point::y() const {
-    return m_problem->get_y(*this);
+    return problem()->geometry().y(m_data);
   }
 
   const string &Point::name() const {
-    return m_problem->point_name(*this);
+    return problem()->point_name(*this);
   }
 
   bool Point::is_close(const Point &other) const {
@@ -15,11 +15,14 @@
 */
 #pragma once
 #include <cstddef>   // For size_t
+#include <cstdint>
 #include <iostream>  // For std::ostream
+#include <limits>
 #include <ranges>
 #include <string>    // For std::string
 #include <boost/json.hpp>
 
+#include "problem_registry.hpp"
 #include "typedef.hpp" // For Yuclid::double
 
 namespace Yuclid {
@@ -28,25 +31,30 @@ namespace Yuclid {
   /**
    * @brief Represents a point in a problem, storing only its index.
    *
-   * For performance reasons, `point` instances only store an index.
-   * Actual coordinate and name data are retrieved from a global (thread-local)
-   * `problem` instance when needed.
+   * For performance reasons, `point` instances only store
+   * a 16-bit index and a 16-bit id of the owning problem, 4 bytes in total.
+   * Actual coordinate and name data are retrieved from the problem
+   * found in `ProblemRegistry` when needed.
    */
   class Point final {
   private:
-    size_t m_data; /**< The index of the point in the global problem data. */
-    /** The problem that owns this point. */
-    const Problem *m_problem;
+    uint16_t m_data; /**< The index of the point in the problem data. */
+    /** The id of the problem that owns this point. */
+    ProblemRegistry::Id m_problem;
 
   public:
+    /** @brief The maximal number of points in a problem. */
+    static constexpr size_t max_points = std::numeric_limits<uint16_t>::max() + size_t{1};
+
     Point() = delete;
 
     /**
      * @brief Constructs a `point` from an integer index.
-     * @param ind The zero-based index of the point.
+     * @param ind The zero-based index of the point, less than `max_points`.
+     * @param owner The id of the problem that owns the point.
      */
-    constexpr Point(size_t ind, const Problem *owner) noexcept :
-      m_data(ind), m_problem(owner) { };
+    constexpr Point(size_t ind, ProblemRegistry::Id owner) noexcept :
+      m_data(static_cast<uint16_t>(ind)), m_problem(owner) { };
 
     /**
      * @brief Gets the raw index stored by the point.
@@ -55,16 +63,19 @@ namespace Yuclid {
     [[nodiscard]] constexpr size_t get() const { return m_data; };
 
     /**
-     * @brief Queries the `x` coordinate of the point from the global problem data.
+     * @brief Gets the problem that owns this point.
+     */
+    [[nodiscard]] const Problem *problem() const { return ProblemRegistry::get(m_problem); }
+
+    /**
+     * @brief Queries the `x` coordinate of the point from the problem's `GeometryCache`.
      * @return The x-coordinate as a `double`.
-     * @throws std::out_of_range if the point's index is invalid.
      */
     [[nodiscard]] double x() const;
 
     /**
-     * @brief Queries the `y` coordinate of the point from the global problem data.
+     * @brief Queries the `y` coordinate of the point from the problem's `GeometryCache`.
      * @return The y-coordinate as a `double`.
-     * @throws std::out_of_range if the point's index is invalid.
      */
     [[nodiscard]] double y() const;
 
@@ -90,7 +101,7 @@ namespace Yuclid {
      * @brief Compares two points by their internal indexes.
      *
      * Provides all comparison operators (`<`, `<=`, `>`, `>=`, `==`, `!=`)
-     * based on the underlying `size_t` index.
+     * based on the underlying index.
      */
     auto operator<=>(const Point &other) const = default;
 
@@ -103,9 +114,9 @@ namespace Yuclid {
      * @return An `std::views` compatible object that yields `Point` objects.
      */
     [[nodiscard]] auto up_to() const {
-      return std::views::iota(static_cast<size_t>(0), m_data)
-        | std::views::transform([this](size_t ind) {
-          return Point(ind, m_problem);
+      return std::views::iota(static_cast<size_t>(0), get())
+        | std::views::transform([owner = m_problem](size_t ind) {
+          return Point(ind, owner);
         });
     }
   };
@@ -15,6 +15,7 @@
 */
 #include "slope_angle.hpp"
 #include "point.hpp"         // For point::is_close() and coordinate access
+#include "problem.hpp"       // For the cached slopes
 #include "typedef.hpp" // For double type
 #include "numbers/add_circle.hpp" // For AddCircle
 #include <algorithm> // For std::min, std::max
@@ -42,24 +43,9 @@ namespace Yuclid { // Consolidate into a single namespace block
   }
 
   SlopeAngle::operator AddCircle<double>() const {
-    // Retrieve coordinates from the points
-    double const x1 = m_left.x();
-    double const y1 = m_left.y();
-    double const x2 = m_right.x();
-    double const y2 = m_right.y();
-
-    // Calculate delta x and delta y
-    double const dx = x2 - x1;
-    double const dy = y2 - y1;
-
-    // Calculate the angle using atan2. atan2 returns angle in radians in range (-pi, pi].
-    double const angle_radians = atan2(dy, dx);
-
-    // Normalize the angle to be in terms of pi (where 1.0 represents pi radians).
+    // The cache stores the angle in terms of pi (where 1.0 represents pi radians).
     // The AddCircle constructor will then normalize this result to the [0, 1) range.
-    double const normalized_by_pi = angle_radians / std::numbers::pi_v<double>;
-
-    return AddCircle<double>(normalized_by_pi);
+    return AddCircle<double>(m_left.problem()->geometry().slope(m_left.get(), m_right.get()));
   }
 
   size_t hash_value(const SlopeAngle& arg) {
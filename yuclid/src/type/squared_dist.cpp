@@ -16,6 +16,7 @@
 #include "squared_dist.hpp"
 #include "dist.hpp"
 #include "type/point.hpp"
+#include "problem.hpp"
 #include <algorithm> // For std::min and std::max
 #include <cstddef>
 #include <iostream>  // For std::ostream
@@ -47,19 +48,14 @@ namespace Yuclid {
   /**
    * @brief Implicit conversion operator to `Yuclid::double`.
    *
-   * Calculates the squared Euclidean distance between the `m_left` and `m_right`
-   * points using their `x()` and `y()` coordinates obtained from the global problem data.
+   * Looks up the squared Euclidean distance between the `m_left` and `m_right`
+   * points in the problem's `GeometryCache`.
    * Formula: $(x_2 - x_1)^2 + (y_2 - y_1)^2$
    *
    * @return The squared length of the segment as a `double`.
    */
   SquaredDist::operator double() const {
-    // Calculate the differences
-    double const dx = m_right.x() - m_left.x();
-    double const dy = m_right.y() - m_left.y();
-
-    // Calculate and return the squared Euclidean distance
-    return (dx * dx) + (dy * dy);
+    return m_left.problem()->geometry().squared_dist(m_left.get(), m_right.get());
   }
 
   SquaredDist::operator Dist() const {
@@ -15,7 +15,9 @@
 */
 #pragma once
 #include <boost/container_hash/hash_fwd.hpp>
-#ifdef WITH_SAFE_NUMERICS
+#ifdef WITH_BIG_INTEGERS
+#include "numbers/hybrid_int.hpp"
+#elif defined(WITH_SAFE_NUMERICS)
 #include <exception> //NOLINT
 #include <boost/container_hash/hash.hpp>
 #include <boost/safe_numerics/safe_integer.hpp>
@@ -45,14 +47,24 @@ namespace Yuclid {
   using UnsafeInt = int64_t;
   using UnsafeNat = uint64_t;
 
-  /** Signed integer numbers we use throughout the program. */
-#ifdef WITH_SAFE_NUMERICS
+  /**
+   * @brief Signed integer numbers we use throughout the program.
+   *
+   * With `WITH_BIG_INTEGERS`, these are machine words
+   * that are promoted to arbitrary precision on overflow.
+   * Otherwise, with `WITH_SAFE_NUMERICS`, an overflow throws an exception.
+   */
+#if defined(WITH_BIG_INTEGERS)
+  using Int = HybridInt<UnsafeInt>;
+#elif defined(WITH_SAFE_NUMERICS)
   using Int = boost::safe_numerics::safe<UnsafeInt>;
 #else
   using Int = UnsafeInt;
 #endif
 
-#ifdef WITH_SAFE_NUMERICS
+#if defined(WITH_BIG_INTEGERS)
+  using Nat = HybridInt<UnsafeNat>;
+#elif defined(WITH_SAFE_NUMERICS)
   using Nat = boost::safe_numerics::safe<UnsafeNat>;
 #else
   using Nat = UnsafeNat;
@@ -92,6 +104,21 @@ namespace Yuclid {
 
 namespace boost {
 
+#ifdef WITH_BIG_INTEGERS
+  inline size_t hash_value(const Yuclid::Rat& val) {
+    size_t seed = 0;
+    hash_combine(seed, val.numerator());
+    hash_combine(seed, val.denominator());
+    return seed;
+  }
+
+  inline size_t hash_value(const Yuclid::NNRat& val) {
+    size_t seed = 0;
+    hash_combine(seed, val.numerator());
+    hash_combine(seed, val.denominator());
+    return seed;
+  }
+#else
   inline size_t hash_value(const Yuclid::Rat& val) {
     size_t seed = 0;
     hash_combine<Yuclid::UnsafeInt>(seed, static_cast<Yuclid::UnsafeInt>(val.numerator()));
@@ -105,5 +132,6 @@ namespace boost {
     hash_combine<Yuclid::UnsafeNat>(seed, static_cast<Yuclid::UnsafeNat>(val.denominator()));
     return seed;
   }
+#endif
 
 }
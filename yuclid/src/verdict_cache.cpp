@@ -0,0 +1,57 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "verdict_cache.hpp"
+
+#include "statement/statement.hpp"
+#include "statement/statement_key.hpp"
+#include <boost/container_hash/hash.hpp>
+#include <cstddef>
+#include <format>
+#include <mutex>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace Yuclid {
+
+  bool VerdictCache::check_numerically(const Statement &stmt) {
+    StatementKey key(stmt);
+    Shard &shard = m_shards[hash_value(key) % num_shards]; // NOLINT(*-constant-array-index)
+    {
+      lock_guard const lock(shard.mutex);
+      auto found = shard.verdicts.find(key);
+      if (found != shard.verdicts.end()) {
+        m_hits.fetch_add(1, memory_order_relaxed);
+        return found->second;
+      }
+    }
+    // Check outside of the lock, so other threads can use the shard meanwhile.
+    bool const verdict = stmt.check_numerically();
+    m_misses.fetch_add(1, memory_order_relaxed);
+    lock_guard const lock(shard.mutex);
+    shard.verdicts.emplace(std::move(key), verdict);
+    return verdict;
+  }
+
+  string VerdictCache::to_string() const {
+    size_t const num_hits = hits();
+    size_t const total = num_hits + misses();
+    double const rate = total == 0 ? 0.0 : 100.0 * static_cast<double>(num_hits) / static_cast<double>(total);
+    return format("{} hits, {} misses ({:.1f}%)", num_hits, misses(), rate);
+  }
+
+}
@@ -0,0 +1,69 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "statement/statement_key.hpp"
+#include <array>
+#include <atomic>
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace Yuclid {
+  class Statement;
+
+  /**
+   * @brief Memoized results of `Statement::check_numerically()`.
+   *
+   * Theorems matched on the same diagram share many hypotheses
+   * (`ncoll A B C`, `cong O A O B` etc),
+   * so each statement is checked once and its verdict is looked up afterwards.
+   * Statements are identified by their `StatementKey`,
+   * so equal statements share a verdict
+   * even if they were created by different theorems.
+   *
+   * The cache is split into shards with their own locks,
+   * so it may be used from several threads at the same time.
+   * Two threads may check the same statement concurrently;
+   * both store the same verdict.
+   */
+  class VerdictCache final {
+  public:
+    static constexpr size_t num_shards = 64;
+
+    /** @brief The cached verdict for `stmt`, computed on the first call. */
+    [[nodiscard]] bool check_numerically(const Statement &stmt);
+
+    [[nodiscard]] size_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] size_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+    /** @brief Hits, misses and the hit rate in the form `120 hits, 30 misses (80.0%)`. */
+    [[nodiscard]] std::string to_string() const;
+
+  private:
+    struct Shard {
+      std::mutex mutex;
+      boost::unordered_flat_map<StatementKey, bool, boost::hash<StatementKey>> verdicts;
+    };
+
+    std::array<Shard, num_shards> m_shards;
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+  };
+
+}
@@ -0,0 +1,197 @@
+#!/usr/bin/env python
+"""
+Compare two sets of `yuclid` command line options on a set of problems.
+
+For each input file, run `yuclid` with the baseline options
+and with the candidate options, report the wall clock time of both runs,
+and check that both runs print the same proof.
+With `--ar-stats`, also compare the sizes of the final AR echelon forms.
+With `--allow-diff`, the proofs may differ,
+and `--same-status` still checks that both runs solve the same problems.
+
+Example:
+
+    python benchmark.py --yuclid build/src/yuclid \\
+        --baseline="--scheduler level" --candidate="--scheduler watch" \\
+        imo_ag_30/*.txt
+"""
+import argparse
+import json
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+
+AR_STATS_RE = re.compile(
+    r"AR (.+) table: (\d+) rows, ([\d.]+) terms per row, "
+    r"coefficients of ([\d.]+) bits on average and up to (\d+) bits"
+)
+
+
+def run_yuclid(yuclid, options, input_file, repeat, log_level="warning", may_fail=False):
+    """
+    Run `yuclid` `repeat` times,
+    return its output, its log, its exit code and the best time.
+
+    Unless `may_fail`, a nonzero exit code is an error.
+    """
+    best = None
+    output = None
+    log = None
+    returncode = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        res = subprocess.run(
+            [yuclid, "--use-json", "--log-level", log_level]
+            + options
+            + ["--input-file", input_file],
+            capture_output=True,
+            text=True,
+        )
+        elapsed = time.perf_counter() - start
+        if res.returncode != 0 and not may_fail:
+            raise RuntimeError(
+                f"`yuclid {' '.join(options)}` failed on {input_file}:\n{res.stderr}"
+            )
+        best = elapsed if best is None else min(best, elapsed)
+        output = res.stdout
+        log = res.stderr
+        returncode = res.returncode
+    return output, log, returncode, best
+
+
+def solve_status(output, returncode):
+    """The exit code and the `status` reported by `yuclid --use-json`."""
+    try:
+        status = json.loads(output).get("status")
+    except ValueError:
+        status = None
+    return returncode, status
+
+
+def add_ar_stats(totals, log):
+    """Add the echelon form sizes logged by `yuclid` to `totals`, by table."""
+    for match in AR_STATS_RE.finditer(log):
+        table, rows, terms_per_row, mean_bits, max_bits = match.groups()
+        rows = int(rows)
+        terms = float(terms_per_row) * rows
+        total = totals.setdefault(table, {"rows": 0, "terms": 0.0, "bits": 0.0, "max_bits": 0})
+        total["rows"] += rows
+        total["terms"] += terms
+        total["bits"] += float(mean_bits) * terms
+        total["max_bits"] = max(total["max_bits"], int(max_bits))
+
+
+def print_ar_stats(name, totals):
+    for table, total in sorted(totals.items()):
+        print(
+            f"{name + ' ' + table:<40} {total['terms'] / total['rows']:>12.2f} "
+            f"{total['bits'] / total['terms']:>12.1f} {total['max_bits']:>12}"
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--yuclid", required=True, help="Path to the `yuclid` binary")
+    parser.add_argument("--baseline", default="", help="Options for the baseline runs")
+    parser.add_argument("--candidate", default="", help="Options for the candidate runs")
+    parser.add_argument("--repeat", type=int, default=1, help="Take the best of N runs")
+    parser.add_argument(
+        "--allow-diff",
+        action="store_true",
+        help="Don't fail if the outputs differ (e.g., when benchmarking heuristics)",
+    )
+    parser.add_argument(
+        "--ar-stats",
+        action="store_true",
+        help="Also report terms per row and coefficient bits of the AR tables",
+    )
+    parser.add_argument(
+        "--same-status",
+        action="store_true",
+        help="Fail unless both runs exit with the same code and report the same status, "
+        "even with `--allow-diff`; nonzero exit codes aren't errors then",
+    )
+    parser.add_argument(
+        "--max-terms-ratio",
+        type=float,
+        help="With `--ar-stats`, fail if an AR table of the candidate has more terms in total "
+        "than this times the same table of the baseline",
+    )
+    parser.add_argument("input_files", nargs="+")
+    args = parser.parse_args()
+
+    baseline = shlex.split(args.baseline)
+    candidate = shlex.split(args.candidate)
+
+    print(f"{'problem':<40} {'baseline, s':>12} {'candidate, s':>12} {'speedup':>8}")
+    total_baseline = 0.0
+    total_candidate = 0.0
+    mismatches = []
+    status_mismatches = []
+    log_level = "debug" if args.ar_stats else "warning"
+    stats_baseline = {}
+    stats_candidate = {}
+    for input_file in args.input_files:
+        out_baseline, log_baseline, code_baseline, t_baseline = run_yuclid(
+            args.yuclid, baseline, input_file, args.repeat, log_level, args.same_status
+        )
+        out_candidate, log_candidate, code_candidate, t_candidate = run_yuclid(
+            args.yuclid, candidate, input_file, args.repeat, log_level, args.same_status
+        )
+        add_ar_stats(stats_baseline, log_baseline)
+        add_ar_stats(stats_candidate, log_candidate)
+        total_baseline += t_baseline
+        total_candidate += t_candidate
+        same = out_baseline == out_candidate
+        if not same:
+            mismatches.append(input_file)
+        status_baseline = solve_status(out_baseline, code_baseline)
+        status_candidate = solve_status(out_candidate, code_candidate)
+        same_status = status_baseline == status_candidate
+        if not same_status:
+            status_mismatches.append(input_file)
+        name = input_file.rsplit("/", 1)[-1]
+        note = "" if same else "  OUTPUT DIFFERS"
+        if args.same_status and not same_status:
+            note += f"  STATUS {status_baseline} VS {status_candidate}"
+        print(
+            f"{name:<40} {t_baseline:>12.3f} {t_candidate:>12.3f} "
+            f"{t_baseline / t_candidate:>7.2f}x{note}"
+        )
+    print(
+        f"{'total':<40} {total_baseline:>12.3f} {total_candidate:>12.3f} "
+        f"{total_baseline / total_candidate:>7.2f}x"
+    )
+
+    if args.ar_stats:
+        print()
+        print(f"{'AR table':<40} {'terms/row':>12} {'mean bits':>12} {'max bits':>12}")
+        print_ar_stats("baseline", stats_baseline)
+        print_ar_stats("candidate", stats_candidate)
+
+    failed = False
+    if mismatches and not args.allow_diff:
+        print(f"Outputs differ on {len(mismatches)} problem(s)", file=sys.stderr)
+        failed = True
+    if status_mismatches and args.same_status:
+        print(f"Statuses differ on {len(status_mismatches)} problem(s)", file=sys.stderr)
+        failed = True
+    if args.ar_stats and args.max_terms_ratio is not None:
+        for table, total in sorted(stats_candidate.items()):
+            limit = args.max_terms_ratio * stats_baseline.get(table, {"terms": 0.0})["terms"]
+            if total["terms"] > limit:
+                print(
+                    f"AR {table} tables have {total['terms']:.0f} terms, "
+                    f"more than the limit of {limit:.0f}",
+                    file=sys.stderr,
+                )
+                failed = True
+    if failed:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
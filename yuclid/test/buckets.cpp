@@ -0,0 +1,101 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE buckets_tests
+#include "buckets.hpp"
+#include "numbers/util.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  vector<size_t> bucket_sizes(const vector<double> &keys, BucketStats *stats = nullptr) {
+    vector<size_t> res;
+    foreach_bucket(keys, [](double key) { return key; }, [&res](span<const double> bucket) {
+      res.push_back(bucket.size());
+    }, stats);
+    return res;
+  }
+
+  vector<vector<double>> all_bucket_keys(const vector<double> &keys) {
+    vector<vector<double>> res;
+    for (span<const double> const bucket : all_buckets(keys, [](double key) { return key; })) {
+      res.emplace_back(bucket.begin(), bucket.end());
+    }
+    return res;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(buckets_tests)
+
+BOOST_AUTO_TEST_CASE(close_keys) {
+  BOOST_TEST(bucket_sizes({}).empty());
+  BOOST_TEST((bucket_sizes({0.0, EPS / 10, 1.0, 1.0, 2.0}) == vector<size_t>{2, 2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(drift_is_split) {
+  // Each step is below `EPS`, but the chain is much longer than `MAX_BUCKET_DIAMETER`.
+  vector<double> keys;
+  for (size_t i = 0; i < 100; ++ i) {
+    keys.push_back(0.5 * EPS * static_cast<double>(i));
+  }
+  BucketStats stats;
+  auto const sizes = bucket_sizes(keys, &stats);
+  BOOST_TEST(sizes.size() == 5U);
+  // Each bucket after a split also starts with the last key before it.
+  BOOST_TEST(sizes.front() == 20U);
+  for (size_t const size : sizes) {
+    BOOST_TEST(size <= 21U);
+  }
+  BOOST_TEST(stats.num_buckets() == 5U);
+  BOOST_TEST(stats.num_splits() == 4U);
+  BOOST_TEST(stats.max_size() == 21U);
+}
+
+BOOST_AUTO_TEST_CASE(equal_keys_straddling_a_split) {
+  vector<double> keys;
+  for (size_t i = 0; i < 12; ++ i) {
+    keys.push_back(0.9 * EPS * static_cast<double>(i));
+  }
+  // Equal up to rounding, and the second one drifted too far from `0`.
+  double const left = MAX_BUCKET_DIAMETER - EPS / 1000;
+  double const right = MAX_BUCKET_DIAMETER + EPS / 1000;
+  keys.push_back(left);
+  keys.push_back(right);
+  keys.push_back(right + 0.9 * EPS);
+  auto const buckets = all_bucket_keys(keys);
+  BOOST_REQUIRE(buckets.size() == 2U);
+  BOOST_TEST(buckets[0].size() == 13U);
+  BOOST_TEST((buckets[1] == vector<double>{0.9 * EPS * 11, left, right, right + 0.9 * EPS}));
+}
+
+BOOST_AUTO_TEST_CASE(histogram) {
+  BucketStats stats;
+  BOOST_TEST(stats.to_string() == "no buckets; largest 0, 0 split(s)");
+  bucket_sizes({0.0, 1.0, 1.0, 2.0, 2.0, 2.0, 3.0, 3.0, 3.0, 3.0}, &stats);
+  BOOST_TEST(stats.bin(0) == 1U);
+  BOOST_TEST(stats.bin(1) == 2U);
+  BOOST_TEST(stats.bin(2) == 1U);
+  BOOST_TEST(stats.to_string() == "1: 1, 2-3: 2, 4-7: 1; largest 4, 0 split(s)");
+  stats.add(1000000);
+  BOOST_TEST(stats.bin(BucketStats::num_bins - 1) == 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE circle_registry_tests
+#include "circle_registry.hpp"
+#include "points_fixture.hpp"
+#include "type/point.hpp"
+#include <array>
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_FIXTURE_TEST_SUITE(circle_registry_tests, PointsFixture<10>)
+
+BOOST_AUTO_TEST_CASE(merge_by_shared_triples) {
+  CircleRegistry registry;
+  registry.add_quadrangle({pt(3), pt(1), pt(2), pt(0)});
+  registry.add_quadrangle({pt(7), pt(6), pt(8), pt(9)});
+  // Shares `p1, p2, p3` with the first one.
+  registry.add_quadrangle({pt(1), pt(2), pt(3), pt(5)});
+  // Shares only two points with each of the circles above.
+  registry.add_quadrangle({pt(0), pt(1), pt(6), pt(7)});
+  auto const circles = registry.circles();
+  BOOST_TEST_REQUIRE(circles.size() == 3U);
+  BOOST_TEST((circles[0] == vector<Point>{pt(0), pt(1), pt(2), pt(3), pt(5)}));
+  BOOST_TEST((circles[1] == vector<Point>{pt(0), pt(1), pt(6), pt(7)}));
+  BOOST_TEST((circles[2] == vector<Point>{pt(6), pt(7), pt(8), pt(9)}));
+}
+
+BOOST_AUTO_TEST_CASE(basis_of_large_circles) {
+  CircleRegistry registry;
+  registry.add_required_points({pt(9), pt(8), pt(7), pt(6)});
+  size_t const small = CircleRegistry::max_full_size;
+  size_t const large = small + 1;
+  BOOST_TEST(registry.uses_quadrangle(1, 2, small, {pt(1), pt(2), pt(3), pt(4)}));
+  BOOST_TEST(!registry.uses_quadrangle(1, 2, large, {pt(1), pt(2), pt(3), pt(4)}));
+  BOOST_TEST(!registry.uses_quadrangle(0, 2, large, {pt(0), pt(2), pt(3), pt(4)}));
+  BOOST_TEST(registry.uses_quadrangle(0, 1, large, {pt(0), pt(1), pt(3), pt(4)}));
+  BOOST_TEST(registry.uses_quadrangle(6, 7, large, {pt(6), pt(7), pt(8), pt(9)}));
+  BOOST_TEST(registry.uses_triangle(0, large, {pt(0), pt(2), pt(3)}));
+  BOOST_TEST(!registry.uses_triangle(1, large, {pt(1), pt(2), pt(3)}));
+  BOOST_TEST(registry.uses_triangle(6, large, {pt(9), pt(7), pt(6)}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
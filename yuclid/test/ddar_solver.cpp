@@ -0,0 +1,147 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE ddar_solver_tests
+#include "config_options.hpp"
+#include "problem.hpp"
+#include "solver/ddar_solver.hpp"
+#include "solver/statement_proof.hpp"
+#include "statement/equal_line_angles.hpp"
+#include "statement/para.hpp"
+#include "type/point.hpp"
+#include "type/slope_angle.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  struct Fixture {
+    Problem prob;
+    Config config{vector<string>{"--scheduler=watch", "--ar-union-find"}};
+
+    Fixture() {
+      // `ab`, `cd` and `ef` are parallel, so are `gh` and `ij`.
+      std::ignore = prob.add_point("a", 0.0, 0.0);
+      std::ignore = prob.add_point("b", 1.0, 0.0);
+      std::ignore = prob.add_point("c", 0.0, 1.0);
+      std::ignore = prob.add_point("d", 1.0, 1.0);
+      std::ignore = prob.add_point("e", 0.0, 2.0);
+      std::ignore = prob.add_point("f", 1.0, 2.0);
+      std::ignore = prob.add_point("g", 0.0, 3.0);
+      std::ignore = prob.add_point("h", 1.0, 4.0);
+      std::ignore = prob.add_point("i", 2.0, 3.0);
+      std::ignore = prob.add_point("j", 3.0, 4.0);
+    }
+
+    [[nodiscard]] SlopeAngle line(const string &left, const string &right) const {
+      return {prob.find_point(left), prob.find_point(right)};
+    }
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(ddar_solver_tests, Fixture)
+
+/**
+ * With `r = ab`, `x = cd`, `w = ef`, `s = gh`, `t = ij`,
+ * the rows are `r - x + s - t = 0` and `s - t = 0`.
+ * The goal `x - w = 0` becomes provable once `w - r = 0` merges `w` into the class of `r`,
+ * though neither of them may be the leading variable of the goal.
+ */
+BOOST_AUTO_TEST_CASE(merge_wakes_remainder_variables) {
+  DDARSolver solver(&prob, &config.solver());
+  SlopeAngle const r = line("a", "b");
+  SlopeAngle const x = line("c", "d");
+  SlopeAngle const w = line("e", "f");
+  SlopeAngle const s = line("g", "h");
+  SlopeAngle const t = line("i", "j");
+  solver.insert_statement(make_unique<EqualLineAngles>(x, r, s, t))->prove_by_assumption();
+  solver.insert_statement(make_unique<Parallel>(s, t))->prove_by_assumption();
+
+  StatementProof *goal = solver.insert_statement(make_unique<Parallel>(x, w));
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+  const auto *eqn = goal->reduced_equation<SlopeAngle>();
+  BOOST_REQUIRE(eqn != nullptr);
+  const auto *sys = eqn->linear_system();
+  for (const auto &term : eqn->remainder().lhs()) {
+    BOOST_TEST(sys->is_watched_by(term.first, goal));
+  }
+  BOOST_TEST(sys->is_watched_by(w, goal));
+
+  solver.insert_statement(make_unique<Parallel>(w, r))->prove_by_assumption();
+  // The goal was notified, so the watch-list scheduler would retry it.
+  BOOST_TEST(!sys->is_watched_by(w, goal));
+  goal->make_progress();
+  BOOST_TEST(goal->is_proved());
+}
+
+/**
+ * The goal `x - w = 0` is stuck after `x - w + s - t = 0`
+ * and is in the span once `s - t = 0` adds a pivot.
+ * A reduction skipped as up to date would miss it.
+ */
+BOOST_AUTO_TEST_CASE(stuck_goal_is_reduced_after_new_pivot) {
+  DDARSolver solver(&prob, &config.solver());
+  SlopeAngle const x = line("c", "d");
+  SlopeAngle const w = line("e", "f");
+  SlopeAngle const s = line("g", "h");
+  SlopeAngle const t = line("i", "j");
+  StatementProof *goal = solver.insert_statement(make_unique<Parallel>(x, w));
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+
+  solver.insert_statement(make_unique<EqualLineAngles>(w, x, s, t))->prove_by_assumption();
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+
+  solver.insert_statement(make_unique<Parallel>(s, t))->prove_by_assumption();
+  goal->make_progress();
+  BOOST_TEST(goal->is_proved());
+}
+
+/**
+ * Same as above, but the last step links `w`,
+ * which is in the remainder of the goal, to `r`.
+ */
+BOOST_AUTO_TEST_CASE(stuck_goal_is_reduced_after_new_link) {
+  DDARSolver solver(&prob, &config.solver());
+  SlopeAngle const r = line("a", "b");
+  SlopeAngle const x = line("c", "d");
+  SlopeAngle const w = line("e", "f");
+  SlopeAngle const s = line("g", "h");
+  SlopeAngle const t = line("i", "j");
+  StatementProof *goal = solver.insert_statement(make_unique<Parallel>(x, w));
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+
+  solver.insert_statement(make_unique<EqualLineAngles>(x, r, s, t))->prove_by_assumption();
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+
+  solver.insert_statement(make_unique<Parallel>(s, t))->prove_by_assumption();
+  goal->make_progress();
+  BOOST_TEST(!goal->is_proved());
+
+  solver.insert_statement(make_unique<Parallel>(w, r))->prove_by_assumption();
+  goal->make_progress();
+  BOOST_TEST(goal->is_proved());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
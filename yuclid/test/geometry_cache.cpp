@@ -0,0 +1,82 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE geometry_cache_tests
+#include "geometry_cache.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  const vector<pair<double, double>> points {
+    {0.0, 0.0}, {1.0, 0.0}, {0.3, 0.7}, {-0.25, 0.125}, {0.5, -2.0}
+  };
+
+  GeometryCache make_cache() {
+    GeometryCache cache;
+    for (const auto &[x, y] : points) {
+      cache.add_point(x, y);
+    }
+    return cache;
+  }
+
+  void check_values(const GeometryCache &cache) {
+    for (size_t i = 0; i < points.size(); ++ i) {
+      BOOST_TEST(cache.x(i) == points[i].first);
+      BOOST_TEST(cache.y(i) == points[i].second);
+      for (size_t j = 0; j < points.size(); ++ j) {
+        double const dx = points[j].first - points[i].first;
+        double const dy = points[j].second - points[i].second;
+        // The cache must return exactly the same values as direct computations.
+        BOOST_TEST(cache.squared_dist(i, j) == (dx * dx) + (dy * dy));
+        BOOST_TEST(cache.dist(i, j) == sqrt((dx * dx) + (dy * dy)));
+        BOOST_TEST(cache.slope(i, j) == atan2(dy, dx) / numbers::pi_v<double>);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(geometry_cache_tests)
+
+BOOST_AUTO_TEST_CASE(without_tables) {
+  check_values(make_cache());
+}
+
+BOOST_AUTO_TEST_CASE(with_tables) {
+  GeometryCache cache = make_cache();
+  cache.build_tables();
+  // The first pass fills the tables, the second pass reads them.
+  check_values(cache);
+  check_values(cache);
+}
+
+BOOST_AUTO_TEST_CASE(add_point_discards_tables) {
+  GeometryCache cache = make_cache();
+  cache.build_tables();
+  BOOST_TEST(cache.dist(0, 1) == 1.0);
+  cache.add_point(3.0, 4.0);
+  BOOST_TEST(cache.size() == points.size() + 1);
+  BOOST_TEST(cache.dist(0, points.size()) == 5.0);
+  cache.build_tables();
+  BOOST_TEST(cache.dist(points.size(), 0) == 5.0);
+  BOOST_TEST(cache.dist(0, 1) == 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,219 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE hybrid_int_tests
+#include "numbers/hybrid_int.hpp"
+#include <boost/safe_numerics/safe_integer.hpp>
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  using HInt = HybridInt<int64_t>;
+  using HNat = HybridInt<uint64_t>;
+  using HRat = boost::rational<HInt>;
+  using SafeRat = boost::rational<boost::safe_numerics::safe<int64_t>>;
+
+  constexpr int64_t max64 = numeric_limits<int64_t>::max();
+  constexpr int64_t min64 = numeric_limits<int64_t>::min();
+
+  /**
+   * @brief A workload similar to Gaussian elimination in the AR module:
+   * many multiply-adds of rationals with small numerators and denominators.
+   */
+  template <typename RatT>
+  RatT axpy_workload(int iterations) {
+    RatT acc(0);
+    for (int i = 0; i < iterations; ++ i) {
+      RatT const coeff(1 + (i % 7), 2 + (i % 5));
+      RatT const term((i % 11) - 5, 1 + (i % 3));
+      acc += coeff * term;
+      acc -= RatT(i % 13, 6);
+      if (i % 64 == 0) {
+        acc = RatT(i % 17, 1 + (i % 4));
+      }
+    }
+    return acc;
+  }
+
+  /** @brief Sort rationals, as we do for the keys of ordered containers. */
+  template <typename RatT>
+  RatT sort_workload(int iterations) {
+    vector<RatT> values;
+    values.reserve(iterations);
+    for (int i = 0; i < iterations; ++ i) {
+      values.emplace_back((i * 7919) % 1009 - 504, 1 + (i % 97));
+    }
+    ranges::sort(values);
+    return values[values.size() / 2];
+  }
+
+  template <typename RatT>
+  double time_workload(RatT (*workload)(int), int iterations, RatT &result) {
+    auto const start = chrono::steady_clock::now();
+    result = workload(iterations);
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  }
+
+  template <typename Workload>
+  void compare_with_safe(const char *name, int iterations) {
+    HRat hybrid;
+    SafeRat safe;
+    // Warm up
+    time_workload(Workload::template run<HRat>, iterations / 10, hybrid);
+    time_workload(Workload::template run<SafeRat>, iterations / 10, safe);
+
+    double const t_hybrid = time_workload(Workload::template run<HRat>, iterations, hybrid);
+    double const t_safe = time_workload(Workload::template run<SafeRat>, iterations, safe);
+    BOOST_TEST(static_cast<int64_t>(hybrid.numerator()) == static_cast<int64_t>(safe.numerator()));
+    BOOST_TEST(static_cast<int64_t>(hybrid.denominator()) == static_cast<int64_t>(safe.denominator()));
+    BOOST_TEST_MESSAGE(name << ": rational<HybridInt<int64_t>> " << t_hybrid << "s, "
+                       << "rational<safe<int64_t>> " << t_safe << "s, "
+                       << "ratio " << t_hybrid / t_safe);
+  }
+
+  struct Axpy {
+    template <typename RatT>
+    static RatT run(int iterations) { return axpy_workload<RatT>(iterations); }
+  };
+
+  struct Sort {
+    template <typename RatT>
+    static RatT run(int iterations) { return sort_workload<RatT>(iterations); }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(hybrid_int_tests)
+
+BOOST_AUTO_TEST_CASE(small_arithmetic) {
+  HInt const a(6);
+  HInt const b(-4);
+  BOOST_TEST(a + b == 2);
+  BOOST_TEST(a - b == 10);
+  BOOST_TEST(a * b == -24);
+  BOOST_TEST(a / b == -1);
+  BOOST_TEST(a % b == 2);
+  BOOST_TEST(-a == -6);
+  BOOST_TEST(b < a);
+  BOOST_TEST((a + b).is_small());
+  BOOST_TEST(HInt::gcd(a, b) == 2);
+  BOOST_TEST(HInt::lcm(a, b) == 12);
+}
+
+BOOST_AUTO_TEST_CASE(promote_and_demote) {
+  HInt big = HInt(max64) + 1;
+  BOOST_TEST(!big.is_small());
+  BOOST_TEST(big.str() == "9223372036854775808");
+  BOOST_TEST(big > max64);
+
+  big -= 1;
+  BOOST_TEST(big.is_small());
+  BOOST_TEST(big == max64);
+
+  HInt square = HInt(max64) * HInt(max64);
+  BOOST_TEST(!square.is_small());
+  square /= max64;
+  BOOST_TEST(square.is_small());
+  BOOST_TEST(square == max64);
+
+  HInt const neg_min = -HInt(min64);
+  BOOST_TEST(!neg_min.is_small());
+  BOOST_TEST(HInt(min64) / -1 == neg_min);
+  BOOST_TEST(HInt(min64) % -1 == 0);
+  BOOST_TEST(HInt::gcd(HInt(min64), HInt(0)) == neg_min);
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_big_values) {
+  HInt big = HInt(max64) + 1;
+  HInt copy = big;
+  BOOST_TEST(&copy.big() == &big.big());
+  BOOST_TEST(copy == HInt(max64) * 2 - HInt(max64) + 1);
+
+  HInt moved = std::move(big);
+  BOOST_TEST(!moved.is_small());
+  big = moved;
+  copy = HInt(1);
+  moved = HInt(2);
+  BOOST_TEST(copy.is_small());
+  BOOST_TEST(big.str() == "9223372036854775808");
+  const HInt &alias = big;
+  big = alias;
+  BOOST_TEST(big.str() == "9223372036854775808");
+}
+
+BOOST_AUTO_TEST_CASE(conversions) {
+  BOOST_TEST(static_cast<int64_t>(HInt(-5)) == -5);
+  BOOST_TEST(static_cast<uint64_t>(HInt(max64) + 1) == uint64_t(max64) + 1);
+  BOOST_CHECK_THROW(static_cast<void>(static_cast<int64_t>(HInt(max64) + 1)), overflow_error);
+
+  HNat const nat = HNat(numeric_limits<uint64_t>::max()) + 1;
+  BOOST_TEST(!nat.is_small());
+  BOOST_TEST(HInt(nat) == HInt(max64) * 2 + 2);
+  BOOST_CHECK_THROW(HNat(0) - 1, range_error);
+  BOOST_CHECK_THROW(HNat(HInt(-1)), range_error);
+
+  BOOST_TEST(nat.bit_width() == 65);
+  BOOST_TEST(HNat(8).bit_width() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(rational) {
+  HRat const big(HInt(max64), 3);
+  HRat const sum = big + big;
+  BOOST_TEST(!sum.numerator().is_small());
+  BOOST_TEST(sum - big == big);
+  BOOST_TEST((sum / big) == HRat(2));
+  BOOST_TEST((sum / big).numerator().is_small());
+  BOOST_TEST(HRat(1, -2) == HRat(-1, 2));
+  BOOST_TEST(HRat(-1, 2) < HRat(1, -3));
+  BOOST_TEST(ratio_to_double(sum.numerator(), sum.denominator()) ==
+             2.0 * static_cast<double>(max64) / 3.0);
+
+  ostringstream out;
+  out << sum;
+  BOOST_TEST(out.str() == "18446744073709551614/3");
+
+  istringstream in("18446744073709551614/3");
+  HRat parsed;
+  in >> parsed;
+  BOOST_TEST(parsed == sum);
+}
+
+BOOST_AUTO_TEST_CASE(hash) {
+  HInt const big = HInt(max64) + 1;
+  BOOST_TEST(hash_value(big - 1) == hash_value(HInt(max64)));
+  BOOST_TEST(hash_value(big) == hash_value(HInt(max64) * 2 - HInt(max64) + 1));
+}
+
+/**
+ * @brief Compare the fast path with `boost::safe_numerics`.
+ *
+ * Timings are noisy on shared CI runners, so this case is disabled by default.
+ * Run it with `test_hybrid_int --run_test=hybrid_int_tests/benchmark_fast_path`.
+ */
+BOOST_AUTO_TEST_CASE(benchmark_fast_path, *boost::unit_test::disabled()) {
+  compare_with_safe<Axpy>("axpy", 2'000'000);
+  compare_with_safe<Sort>("sort", 500'000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+"""
+Check that `yuclid --jobs N` gives the same results as solving files one at a time.
+
+First, run `yuclid` on each input file separately.
+Then run it once on all input files with `--jobs N`,
+with a file that doesn't exist in the middle of the list,
+and check that
+- stdout is the concatenation of the outputs of the separate runs, in the order of input files;
+- the missing file doesn't stop the files after it;
+- the exit code is the first nonzero exit code in the order of input files.
+
+Example:
+
+    python jobs.py --yuclid build/src/yuclid --jobs 4 imo_ag_30/*.txt
+"""
+import argparse
+import shlex
+import subprocess
+import sys
+
+MISSING_FILE = "this_file_does_not_exist.txt"
+
+
+def run_yuclid(yuclid, options, input_files):
+    return subprocess.run(
+        [yuclid, "--use-json", "--log-level", "warning"] + options + input_files,
+        capture_output=True,
+        text=True,
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--yuclid", required=True, help="Path to the `yuclid` binary")
+    parser.add_argument("--jobs", type=int, default=4, help="Number of files to solve at a time")
+    parser.add_argument("--options", default="", help="Options for all runs")
+    parser.add_argument("input_files", nargs="+")
+    args = parser.parse_args()
+
+    options = shlex.split(args.options)
+
+    expected_output = ""
+    expected_code = 0
+    files = list(args.input_files)
+    files.insert(len(files) // 2, MISSING_FILE)
+    for input_file in files:
+        if input_file == MISSING_FILE:
+            code = 1
+        else:
+            res = run_yuclid(args.yuclid, options, [input_file])
+            expected_output += res.stdout
+            code = res.returncode
+        if expected_code == 0:
+            expected_code = code
+
+    res = run_yuclid(args.yuclid, options + ["--jobs", str(args.jobs)], files)
+    print(res.stderr)
+    failed = False
+    if res.stdout != expected_output:
+        print("The output differs from the outputs of separate runs", file=sys.stderr)
+        failed = True
+    if res.returncode != expected_code:
+        print(f"Exit code {res.returncode}, expected {expected_code}", file=sys.stderr)
+        failed = True
+    if MISSING_FILE not in res.stderr:
+        print("The summary doesn't mention the missing file", file=sys.stderr)
+        failed = True
+    if failed:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE line_registry_tests
+#include "line_registry.hpp"
+#include "points_fixture.hpp"
+#include "type/point.hpp"
+#include <array>
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_FIXTURE_TEST_SUITE(line_registry_tests, PointsFixture<8>)
+
+BOOST_AUTO_TEST_CASE(merge_by_shared_pairs) {
+  LineRegistry registry;
+  registry.add_triple({pt(2), pt(0), pt(1)});
+  registry.add_triple({pt(5), pt(6), pt(7)});
+  // Shares `p1, p2` with the first one.
+  registry.add_triple({pt(4), pt(2), pt(1)});
+  // Shares one point with each of the lines above.
+  registry.add_triple({pt(0), pt(3), pt(5)});
+  auto const lines = registry.lines();
+  BOOST_TEST_REQUIRE(lines.size() == 3U);
+  BOOST_TEST((lines[0] == vector<Point>{pt(0), pt(1), pt(2), pt(4)}));
+  BOOST_TEST((lines[1] == vector<Point>{pt(0), pt(3), pt(5)}));
+  BOOST_TEST((lines[2] == vector<Point>{pt(5), pt(6), pt(7)}));
+}
+
+BOOST_AUTO_TEST_CASE(spanning_triples) {
+  auto const triples = LineRegistry::spanning_triples({pt(1), pt(3), pt(4), pt(6)});
+  BOOST_TEST_REQUIRE(triples.size() == 2U);
+  BOOST_TEST((triples[0] == array{pt(1), pt(3), pt(4)}));
+  BOOST_TEST((triples[1] == array{pt(1), pt(3), pt(6)}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
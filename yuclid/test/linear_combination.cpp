@@ -20,8 +20,11 @@
 #include <boost/test/unit_test.hpp>
 #include "numbers/rational.hpp"
 #include <boost/safe_numerics/safe_integer.hpp> // For boost::safe_numerics::safe_base
+#include <chrono>
 #include <cstddef>
+#include <random>
 #include <sstream> // For testing output operator
+#include <vector>
 
 #include "ar/linear_combination.hpp"
 #include "typedef.hpp"
@@ -308,4 +311,98 @@ BOOST_AUTO_TEST_CASE(test_linear_combine) {
     BOOST_CHECK_EQUAL(combined4.terms().at(0).second, R2);
 }
 
+BOOST_AUTO_TEST_CASE(test_axpy) {
+    LinearCombination<size_t> lc = LinearCombination<size_t>(1, R1) + LinearCombination<size_t>(3, R2); // X1 + 2*X3
+    LinearCombination<size_t> const other = LinearCombination<size_t>(2, R1) + LinearCombination<size_t>(3, R1)
+        + LinearCombination<size_t>(4, R_half); // X2 + X3 + 0.5*X4
+
+    lc.axpy(R_neg1 * R2, other); // X1 - 2*X2 - X4
+    BOOST_CHECK_EQUAL(lc.terms().size(), 3);
+    BOOST_CHECK_EQUAL(lc.terms().at(0).first, 1);
+    BOOST_CHECK_EQUAL(lc.terms().at(0).second, R1);
+    BOOST_CHECK_EQUAL(lc.terms().at(1).first, 2);
+    BOOST_CHECK_EQUAL(lc.terms().at(1).second, -R2);
+    BOOST_CHECK_EQUAL(lc.terms().at(2).first, 4);
+    BOOST_CHECK_EQUAL(lc.terms().at(2).second, R_neg1);
+
+    lc.axpy(R0, other); // Unchanged
+    BOOST_CHECK_EQUAL(lc.terms().size(), 3);
+
+    LinearCombination<size_t> empty;
+    empty.axpy(R2, other);
+    BOOST_CHECK(empty == R2 * other);
+}
+
+namespace {
+    /** A random linear combination of `size` distinct variables out of `0..range-1`. */
+    LinearCombination<size_t> random_lc(std::mt19937 &gen, size_t size, size_t range) {
+        std::uniform_int_distribution<size_t> var(0, range - 1);
+        std::uniform_int_distribution<int> num(-5, 5);
+        LinearCombination<size_t> res;
+        while (res.terms().size() < size) {
+            int const coeff = num(gen);
+            if (coeff != 0) {
+                res += LinearCombination<size_t>(var(gen), Rat(coeff, 2));
+            }
+        }
+        return res;
+    }
+}
+
+/**
+ * Check that the in-place merges agree with the binary operators
+ * on random inputs, and report the time each kernel takes.
+ *
+ * Sizes cover the inline case (at most `inline_capacity` terms) and longer rows.
+ */
+BOOST_AUTO_TEST_CASE(benchmark_merge_kernels) {
+    using clock = std::chrono::steady_clock;
+    constexpr size_t num_pairs = 2000;
+    std::mt19937 gen(42);
+    for (size_t const size : {2, 4, 6, 12, 24}) {
+        std::vector<LinearCombination<size_t>> lhs;
+        std::vector<LinearCombination<size_t>> rhs;
+        std::vector<Rat> coeffs;
+        for (size_t ind = 0; ind < num_pairs; ++ ind) {
+            lhs.push_back(random_lc(gen, size, 2 * size));
+            rhs.push_back(random_lc(gen, size, 2 * size));
+            coeffs.emplace_back(static_cast<int>(ind % 7) - 3, 2);
+        }
+
+        std::vector<LinearCombination<size_t>> expected;
+        auto const start_binary = clock::now();
+        for (size_t ind = 0; ind < num_pairs; ++ ind) {
+            expected.push_back(lhs[ind] + coeffs[ind] * rhs[ind]);
+        }
+        auto const binary_time = clock::now() - start_binary;
+
+        std::vector<LinearCombination<size_t>> actual = lhs;
+        auto const start_axpy = clock::now();
+        for (size_t ind = 0; ind < num_pairs; ++ ind) {
+            actual[ind].axpy(coeffs[ind], rhs[ind]);
+        }
+        auto const axpy_time = clock::now() - start_axpy;
+
+        std::vector<LinearCombination<size_t>> sums = lhs;
+        auto const start_add = clock::now();
+        for (size_t ind = 0; ind < num_pairs; ++ ind) {
+            sums[ind] -= rhs[ind];
+        }
+        auto const add_time = clock::now() - start_add;
+
+        for (size_t ind = 0; ind < num_pairs; ++ ind) {
+            BOOST_CHECK(actual[ind] == expected[ind]);
+            BOOST_CHECK(sums[ind] == lhs[ind] - rhs[ind]);
+        }
+        using std::chrono::nanoseconds;
+        BOOST_TEST_MESSAGE(size << " terms: a + c * b "
+                           << std::chrono::duration_cast<nanoseconds>(binary_time).count() / num_pairs
+                           << " ns, a.axpy(c, b) "
+                           << std::chrono::duration_cast<nanoseconds>(axpy_time).count() / num_pairs
+                           << " ns, a -= b "
+                           << std::chrono::duration_cast<nanoseconds>(add_time).count() / num_pairs
+                           << " ns");
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
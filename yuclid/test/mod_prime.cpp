@@ -0,0 +1,48 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE mod_prime_tests
+#include "numbers/mod_prime.hpp"
+#include "typedef.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cstdint>
+#include <optional>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(mod_prime_tests)
+
+BOOST_AUTO_TEST_CASE(arithmetic) {
+  constexpr uint64_t p = ModPrime::modulus;
+  BOOST_TEST(ModPrime::of_int(Int(-1)).value() == p - 1);
+  BOOST_TEST(ModPrime::of_int(Int(static_cast<UnsafeInt>(p) + 5)).value() == 5);
+  BOOST_TEST((ModPrime(p - 1) * ModPrime(p - 1)).value() == 1);
+  BOOST_TEST((ModPrime(p - 1) + ModPrime(2)).value() == 1);
+  BOOST_TEST((ModPrime(1) - ModPrime(2)).value() == p - 1);
+  BOOST_TEST((ModPrime(12345).inverse() * ModPrime(12345)).value() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(rationals) {
+  optional<ModPrime> const half = ModPrime::of_rat(Rat(1, 2));
+  BOOST_TEST_REQUIRE(half.has_value());
+  BOOST_TEST((*half * ModPrime(2)).value() == 1);
+  optional<ModPrime> const c = ModPrime::of_rat(Rat(-3, 7));
+  BOOST_TEST_REQUIRE(c.has_value());
+  BOOST_TEST((*c * ModPrime(7) + ModPrime(3)).value() == 0);
+  BOOST_TEST(!ModPrime::of_rat(Rat(1, Int(static_cast<UnsafeInt>(ModPrime::modulus)))).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE point_grid_tests
+#include "geometry_cache.hpp"
+#include "point_grid.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  vector<size_t> brute_force(const GeometryCache &geom, double x, double y, double radius) {
+    vector<size_t> res;
+    for (size_t ind = 0; ind < geom.size(); ++ ind) {
+      if (hypot(geom.x(ind) - x, geom.y(ind) - y) <= radius) {
+        res.push_back(ind);
+      }
+    }
+    return res;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(point_grid_tests)
+
+BOOST_AUTO_TEST_CASE(same_as_brute_force) {
+  GeometryCache geom;
+  for (int i = 0; i < 50; ++ i) {
+    // Deterministic pseudo-random points in `[-5, 5]²` plus a few duplicates.
+    geom.add_point(5 * sin(i * 1.7), 5 * cos(i * 2.3));
+  }
+  geom.add_point(geom.x(3), geom.y(3));
+  geom.add_point(100.0, -100.0);
+  PointGrid const grid(geom);
+  for (double x = -120; x <= 120; x += 3.7) {
+    for (double y = -120; y <= 120; y += 4.1) {
+      for (double radius : {0.0, 0.5, 2.0, 50.0}) {
+        BOOST_TEST(grid.points_near(x, y, radius) == brute_force(geom, x, y, radius));
+      }
+    }
+  }
+  for (size_t ind = 0; ind < geom.size(); ++ ind) {
+    auto const near = grid.points_near(geom.x(ind), geom.y(ind), 0);
+    BOOST_TEST(near == brute_force(geom, geom.x(ind), geom.y(ind), 0));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(degenerate) {
+  GeometryCache geom;
+  BOOST_TEST(PointGrid(geom).points_near(0.0, 0.0, 1.0).empty());
+  geom.add_point(1.0, 1.0);
+  geom.add_point(1.0, 1.0);
+  PointGrid const grid(geom);
+  BOOST_TEST(grid.points_near(1.0, 1.0, 0.0) == (vector<size_t>{0, 1}));
+  BOOST_TEST(grid.points_near(0.0, 0.0, 1.0).empty());
+  BOOST_TEST(grid.points_near(0.0, 0.0, numeric_limits<double>::infinity()) == (vector<size_t>{0, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(arbitrary_locations) {
+  // Midpoints of the sides of the unit square, the first two coincide.
+  PointGrid const grid({0.5, 0.5, 1.0, 0.0}, {0.5, 0.5, 0.5, 0.5});
+  BOOST_TEST(grid.points_near(0.5, 0.5, 1E-9) == (vector<size_t>{0, 1}));
+  BOOST_TEST(grid.points_near(1.0, 0.5, 0.5) == (vector<size_t>{0, 1, 2}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+#include "problem.hpp"
+#include "type/point.hpp"
+#include <cstddef>
+#include <string>
+#include <tuple>
+
+namespace Yuclid {
+
+  /**
+   * @brief A Boost.Test fixture with a problem of points `p0`, ..., `p{NumPoints - 1}`.
+   *
+   * The `i`-th point is `(i, i²)`, so no three points are collinear.
+   * Use it with `BOOST_FIXTURE_TEST_SUITE`; test cases get the points by `pt(i)`.
+   */
+  template <size_t NumPoints>
+  struct PointsFixture {
+    Problem prob;
+
+    PointsFixture() {
+      for (size_t i = 0; i < NumPoints; ++ i) {
+        auto const coord = static_cast<double>(i);
+        std::ignore = prob.add_point("p" + std::to_string(i), coord, coord * coord);
+      }
+    }
+
+    /** The `i`-th point. */
+    [[nodiscard]] Point pt(size_t i) const { return prob.find_point("p" + std::to_string(i)); }
+  };
+
+}
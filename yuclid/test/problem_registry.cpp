@@ -0,0 +1,78 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE problem_registry_tests
+#include "problem.hpp"
+#include "problem_registry.hpp"
+#include "type/angle.hpp"
+#include "type/point.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <optional>
+#include <utility>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(problem_registry_tests)
+
+BOOST_AUTO_TEST_CASE(compact_points) {
+  BOOST_TEST(sizeof(Point) == 4);
+  BOOST_TEST(sizeof(Angle) == 12);
+}
+
+BOOST_AUTO_TEST_CASE(points_find_their_problem) {
+  Problem first;
+  Problem second;
+  BOOST_TEST(first.id() == ProblemRegistry::no_id);
+  Point const a = first.add_point("a", 1.0, 2.0);
+  Point const b = second.add_point("b", 3.0, 4.0);
+  BOOST_TEST(first.id() != second.id());
+  BOOST_TEST(a.problem() == &first);
+  BOOST_TEST(b.problem() == &second);
+  BOOST_TEST(a.name() == "a");
+  BOOST_TEST(b.x() == 3.0);
+  BOOST_TEST((a != b));
+}
+
+BOOST_AUTO_TEST_CASE(move_keeps_points) {
+  optional<Problem> orig(in_place);
+  Point const a = orig->add_point("a", 1.0, 2.0);
+  Problem moved(std::move(*orig));
+  orig.reset();
+  BOOST_TEST(a.problem() == &moved);
+  BOOST_TEST(a.name() == "a");
+  BOOST_TEST(a.y() == 2.0);
+
+  Problem assigned;
+  std::ignore = assigned.add_point("b", 0.0, 0.0);
+  assigned = std::move(moved);
+  BOOST_TEST(a.problem() == &assigned);
+  BOOST_TEST(assigned.find_point("a") == a);
+}
+
+BOOST_AUTO_TEST_CASE(ids_are_reused) {
+  ProblemRegistry::Id id = ProblemRegistry::no_id;
+  {
+    Problem prob;
+    std::ignore = prob.add_point("a", 0.0, 0.0);
+    id = prob.id();
+  }
+  BOOST_TEST(ProblemRegistry::get(id) == nullptr);
+  Problem prob;
+  std::ignore = prob.add_point("a", 0.0, 0.0);
+  BOOST_TEST(prob.id() == id);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+"""
+Check `yuclid --mode serve` on a short NDJSON session.
+
+Send the requests one at a time and wait for each response before sending the next one,
+so a response that isn't flushed makes the test time out.
+A request that fails must get an `ok: false` response and must not stop the server.
+
+Example:
+
+    python serve.py --yuclid build/src/yuclid simple/menelaus.txt simple/triangle_bisector_forward.txt
+"""
+import argparse
+import json
+import queue
+import subprocess
+import sys
+import threading
+
+TIMEOUT = 300
+
+
+def check(cond, message):
+    if not cond:
+        print(f"FAILED: {message}", file=sys.stderr)
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--yuclid", required=True, help="Path to the `yuclid` binary")
+    parser.add_argument("problem", help="A problem that `--mode ddar` can run on")
+    parser.add_argument("other_problem", help="Another problem, matched with per-request options")
+    args = parser.parse_args()
+
+    with open(args.problem) as f:
+        problem = f.read()
+    with open(args.other_problem) as f:
+        other_problem = f.read()
+
+    # Each request with the check of its response.
+    session = [
+        (
+            json.dumps({"id": 1, "problem": problem}),
+            lambda res: res.get("id") == 1 and res["ok"] and "status" in res["result"],
+        ),
+        (
+            json.dumps({"id": "match", "problem": other_problem, "options": ["--mode", "match"]}),
+            lambda res: res.get("id") == "match" and res["ok"] and isinstance(res["result"], list),
+        ),
+        (
+            "{this is not json",
+            lambda res: not res["ok"] and "error" in res,
+        ),
+        (
+            json.dumps({"id": 4, "problem": problem, "options": ["--mode", "serve"]}),
+            lambda res: res.get("id") == 4 and not res["ok"] and "error" in res,
+        ),
+        (
+            json.dumps({"id": 5, "problem": problem}),
+            lambda res: res.get("id") == 5 and res["ok"] and "status" in res["result"],
+        ),
+    ]
+
+    proc = subprocess.Popen(
+        [args.yuclid, "--mode", "serve", "--log-level", "warning"],
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    lines = queue.Queue()
+
+    def read_lines():
+        for line in proc.stdout:
+            lines.put(line)
+        lines.put(None)
+
+    threading.Thread(target=read_lines, daemon=True).start()
+
+    for request, is_expected in session:
+        proc.stdin.write(request + "\n")
+        proc.stdin.flush()
+        try:
+            line = lines.get(timeout=TIMEOUT)
+        except queue.Empty:
+            proc.kill()
+            check(False, f"no response to {request[:40]!r} in {TIMEOUT} s")
+        check(line is not None, f"the server exited after {request[:40]!r}")
+        response = json.loads(line)
+        check(is_expected(response), f"unexpected response to {request[:40]!r}: {line[:200]}")
+        print(f"{request[:40]!r}: ok={response['ok']}")
+
+    proc.stdin.close()
+    check(proc.wait(timeout=TIMEOUT) == 0, f"the server exited with code {proc.returncode}")
+    check(lines.get(timeout=TIMEOUT) is None, "the server wrote more lines than requests")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE shape_index_tests
+#include "problem.hpp"
+#include "shape_index.hpp"
+#include "type/point.hpp"
+#include "type/triangle.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(shape_index_tests)
+
+BOOST_AUTO_TEST_CASE(similar_triangles_share_a_shape) {
+  Problem prob;
+  Point const a = prob.add_point("a", 0.0, 0.0);
+  Point const b = prob.add_point("b", 1.0, 0.0);
+  Point const c = prob.add_point("c", 0.3, 2.0);
+  // `▵DEF` is `▵ABC` rotated, scaled by 3, and shifted.
+  Point const d = prob.add_point("d", 5.0, 1.0);
+  Point const e = prob.add_point("e", 5.0, 4.0);
+  Point const f = prob.add_point("f", -1.0, 1.9);
+  // `▵GHK` is `▵ABC` reflected in the y-axis and scaled by 1/2.
+  Point const g = prob.add_point("g", 0.0, 0.0);
+  Point const h = prob.add_point("h", -0.5, 0.0);
+  Point const k = prob.add_point("k", -0.15, 1.0);
+  // Close to, but not similar to `▵ABC`.
+  Point const l = prob.add_point("l", 0.3001, 2.0);
+
+  ShapeIndex shapes;
+  BOOST_TEST(shapes.insert(Triangle(a, b, c)) == 0U);
+  BOOST_TEST(shapes.insert(Triangle(d, e, f)) == 1U);
+  BOOST_TEST(shapes.insert(Triangle(a, b, l)) == 2U);
+  BOOST_TEST(shapes.insert(Triangle(g, h, k)) == 3U);
+  BOOST_TEST(shapes.insert(Triangle(a, c, b)) == 4U);
+  BOOST_TEST(shapes.size() == 5U);
+  BOOST_TEST(abs(ShapeIndex::shape(shapes[0]) - ShapeIndex::shape(shapes[3])) < 1E-12);
+  BOOST_TEST(ShapeIndex::shape(shapes[0]).imag() >= 0);
+  BOOST_TEST(ShapeIndex::shape(shapes[3]).imag() >= 0);
+  BOOST_TEST(shapes.same_shape_before(0).empty());
+  BOOST_TEST((shapes.same_shape_before(1) == vector<size_t>{0}));
+  BOOST_TEST(shapes.same_shape_before(2).empty());
+  BOOST_TEST((shapes.same_shape_before(3) == vector<size_t>{0, 1}));
+  BOOST_TEST(shapes.same_shape_before(4).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE slope_index_tests
+#include "geometry_cache.hpp"
+#include "numbers/util.hpp"
+#include "slope_index.hpp"
+#include <algorithm>
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  /** Same test as `Perpendicular::check_equations`. */
+  bool is_perpendicular(const GeometryCache &geom, size_t a, size_t b, size_t c, size_t d) {
+    return approx_eq((geom.x(b) - geom.x(a)) * (geom.x(d) - geom.x(c)),
+                     -(geom.y(b) - geom.y(a)) * (geom.y(d) - geom.y(c)));
+  }
+
+  void check_all_found(const GeometryCache &geom) {
+    SlopeIndex const slopes(geom);
+    size_t const num_pts = geom.size();
+    for (size_t b = 0; b < num_pts; ++ b) {
+      for (size_t a = 0; a < b; ++ a) {
+        auto candidates = slopes.perpendicular_candidates(a, b);
+        ranges::sort(candidates);
+        BOOST_TEST((ranges::adjacent_find(candidates) == candidates.end()));
+        for (size_t d = 0; d < num_pts; ++ d) {
+          for (size_t c = 0; c < d; ++ c) {
+            if (is_perpendicular(geom, a, b, c, d)) {
+              BOOST_TEST(ranges::binary_search(candidates, pair(c, d)));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(slope_index_tests)
+
+BOOST_AUTO_TEST_CASE(grid) {
+  GeometryCache geom;
+  for (int x = -2; x <= 2; ++ x) {
+    for (int y = -2; y <= 2; ++ y) {
+      geom.add_point(x, y);
+    }
+  }
+  geom.build_tables();
+  check_all_found(geom);
+}
+
+BOOST_AUTO_TEST_CASE(near_vertical_and_short) {
+  GeometryCache geom;
+  geom.add_point(0.0, 0.0);
+  geom.add_point(1.0, 0.0);
+  geom.add_point(0.0, 1.0);
+  // The direction of this pair is almost `π`, its perpendicular is almost `π / 2`.
+  geom.add_point(-1.0, 1E-4);
+  geom.add_point(1E-4, -1.0);
+  // Very short pairs are perpendicular to everything up to the absolute tolerance.
+  geom.add_point(0.5, 0.5);
+  geom.add_point(0.5 + 1E-9, 0.5 + 2E-9);
+  check_all_found(geom);
+}
+
+BOOST_AUTO_TEST_CASE(skips_far_directions) {
+  GeometryCache geom;
+  geom.add_point(0.0, 0.0);
+  geom.add_point(1.0, 0.0);
+  geom.add_point(0.0, 1.0);
+  geom.add_point(1.0, 1.0);
+  SlopeIndex const slopes(geom);
+  auto candidates = slopes.perpendicular_candidates(0, 1);
+  ranges::sort(candidates);
+  BOOST_TEST((candidates == vector<pair<size_t, size_t>>{{0, 2}, {1, 3}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE statement_key_tests
+#include "points_fixture.hpp"
+#include "statement/angle_eq.hpp"
+#include "statement/coll.hpp"
+#include "statement/cong.hpp"
+#include "statement/congruent_triangles.hpp"
+#include "statement/line_angle_eq.hpp"
+#include "statement/para.hpp"
+#include "statement/ratio_dist.hpp"
+#include "statement/similar_triangles.hpp"
+#include "statement/statement.hpp"
+#include "statement/statement_key.hpp"
+#include "type/angle.hpp"
+#include "type/dist.hpp"
+#include "type/point.hpp"
+#include "type/slope_angle.hpp"
+#include "type/triangle.hpp"
+#include "typedef.hpp"
+#include <boost/container_hash/hash.hpp>
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_FIXTURE_TEST_SUITE(statement_key_tests, PointsFixture<4>)
+
+BOOST_AUTO_TEST_CASE(same_as_statement_data) {
+  Point const a = pt(0);
+  Point const b = pt(1);
+  Point const c = pt(2);
+  Point const d = pt(3);
+
+  vector<unique_ptr<Statement>> stmts;
+  stmts.push_back(make_unique<DistEqDist>(Dist(a, b), Dist(c, d)));
+  stmts.push_back(make_unique<DistEqDist>(Dist(c, d), Dist(b, a)));
+  stmts.push_back(make_unique<DistEqDist>(Dist(a, c), Dist(b, d)));
+  stmts.push_back(make_unique<Parallel>(SlopeAngle(a, b), SlopeAngle(c, d)));
+  stmts.push_back(make_unique<Collinear>(a, b, c));
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(1, 2)));
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(2, 4)));
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(2, 3)));
+  stmts.push_back(make_unique<LineAngleEq>(SlopeAngle(a, b), SlopeAngle(c, d), Rat(1, 3)));
+  stmts.push_back(make_unique<LineAngleEq>(SlopeAngle(a, b), SlopeAngle(c, d), Rat(4, 3)));
+#ifdef WITH_BIG_INTEGERS
+  // Equal big numbers computed in different ways
+  Nat const big = Nat(numeric_limits<uint64_t>::max()) + 1;
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(big)));
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(big * 3, 3)));
+  stmts.push_back(make_unique<RatioDistEquals>(Dist(a, b), Dist(c, d), NNRat(big + 1)));
+  stmts.push_back(make_unique<LineAngleEq>(SlopeAngle(a, b), SlopeAngle(c, d), Rat(Int(big), 3)));
+  stmts.push_back(make_unique<LineAngleEq>(SlopeAngle(a, b), SlopeAngle(c, d), Rat(-Int(big), 3)));
+#endif
+  // Same names with other arguments, and same arguments with other names
+  stmts.push_back(make_unique<AngleEq>(Angle(a, b, c), Rat(1, 3)));
+  stmts.push_back(make_unique<SimilarTriangles>(Triangle(a, b, c), Triangle(a, b, d), true));
+  stmts.push_back(make_unique<CongruentTriangles>(Triangle(a, b, c), Triangle(a, b, d), true));
+
+  for (const auto &lhs : stmts) {
+    auto const lhs_norm = lhs->normalize();
+    StatementKey const lhs_key(*lhs_norm);
+    for (const auto &rhs : stmts) {
+      auto const rhs_norm = rhs->normalize();
+      StatementKey const rhs_key(*rhs_norm);
+      BOOST_TEST((lhs_key == rhs_key) == (lhs_norm->data() == rhs_norm->data()));
+      if (lhs_key == rhs_key) {
+        BOOST_TEST(hash_value(lhs_key) == hash_value(rhs_key));
+      }
+    }
+  }
+  BOOST_TEST((StatementKey(*stmts[0]->normalize()) == StatementKey(*stmts[1]->normalize())));
+  BOOST_TEST((StatementKey(*stmts[5]) == StatementKey(*stmts[6])));
+#ifdef WITH_BIG_INTEGERS
+  BOOST_TEST((StatementKey(*stmts[10]) == StatementKey(*stmts[11])));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(short_keys_are_inline) {
+  Point const a = pt(0);
+  Point const b = pt(1);
+  Point const c = pt(2);
+  Point const d = pt(3);
+  StatementKey const key(Parallel(SlopeAngle(a, b), SlopeAngle(c, d)));
+  BOOST_TEST(key.words().size() <= StatementKey::Words::static_capacity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
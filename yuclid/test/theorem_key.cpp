@@ -0,0 +1,53 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE theorem_key_tests
+#include "problem.hpp"
+#include "theorem.hpp"
+#include "theorem_key.hpp"
+#include "type/point.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(theorem_key_tests)
+
+BOOST_AUTO_TEST_CASE(equal_iff_same_rule_and_statements) {
+  Problem prob;
+  std::ignore = prob.add_point("a", 0.0, 0.0);
+  std::ignore = prob.add_point("b", 1.0, 0.0);
+  std::ignore = prob.add_point("c", 1.0, 1.0);
+  std::ignore = prob.add_point("d", 0.0, 1.0);
+  Point const a = prob.find_point("a");
+  Point const b = prob.find_point("b");
+  Point const c = prob.find_point("c");
+  Point const d = prob.find_point("d");
+
+  TheoremKey const first(Theorem::equal_angles_of_cong(a, b, d).normalize());
+  TheoremKey const again(Theorem::equal_angles_of_cong(a, b, d).normalize());
+  TheoremKey const converse(Theorem::cong_of_equal_angles(a, b, d).normalize());
+  TheoremKey const other(Theorem::equal_angles_of_cong(c, b, d).normalize());
+
+  BOOST_TEST((first == again));
+  BOOST_TEST(hash_value(first) == hash_value(again));
+  BOOST_TEST(first.name() == again.name());
+  BOOST_TEST(!(first == converse));
+  BOOST_TEST(first.name() != converse.name());
+  BOOST_TEST(!(first == other));
+  BOOST_TEST(first.name() == other.name());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE theorem_stream_tests
+#include "problem.hpp"
+#include "theorem.hpp"
+#include "theorem_key.hpp"
+#include "theorem_stream.hpp"
+#include "type/point.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <map>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace Yuclid;
+
+namespace {
+  struct Fixture {
+    Problem prob;
+    vector<Theorem> theorems;
+    vector<TheoremKey> passed;
+    TheoremSink sink = [this](Theorem &&thm) { passed.emplace_back(thm); };
+    map<string_view, RuleStats> rule_stats;
+
+    Fixture() {
+      std::ignore = prob.add_point("a", 0.0, 0.0);
+      std::ignore = prob.add_point("b", 1.0, 0.0);
+      std::ignore = prob.add_point("c", 1.0, 1.0);
+      std::ignore = prob.add_point("d", 0.0, 1.0);
+      Point const a = prob.find_point("a");
+      Point const b = prob.find_point("b");
+      Point const c = prob.find_point("c");
+      Point const d = prob.find_point("d");
+      theorems.push_back(Theorem::equal_angles_of_cong(a, b, d).normalize());
+      theorems.push_back(Theorem::equal_angles_of_cong(c, b, d).normalize());
+      theorems.push_back(Theorem::cong_of_equal_angles(a, b, d).normalize());
+      theorems.push_back(Theorem::cong_of_equal_angles(c, b, d).normalize());
+    }
+
+    /** The key of the `i`-th theorem. */
+    [[nodiscard]] TheoremKey key(size_t i) const { return TheoremKey(theorems[i]); }
+
+    /** A copy of the `i`-th theorem; theorems aren't copyable, but normalization makes a copy. */
+    [[nodiscard]] Theorem theorem(size_t i) const { return theorems[i].normalize(); }
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(theorem_stream_tests, Fixture)
+
+BOOST_AUTO_TEST_CASE(parts_are_passed_in_order) {
+  TheoremStream stream(sink, rule_stats, 2);
+  stream.open(0, 2);
+  BOOST_TEST(stream.insert(stream.part(0, 1), theorem(1)));
+  stream.finish(stream.part(0, 1));
+  // The first part isn't finished yet.
+  BOOST_TEST(passed.empty());
+  BOOST_TEST(stream.insert(stream.part(0, 0), theorem(0)));
+  stream.finish(stream.part(0, 0));
+  BOOST_TEST(passed.size() == 2);
+  BOOST_TEST((passed[0] == key(0)));
+  BOOST_TEST((passed[1] == key(1)));
+  BOOST_TEST(!stream.done());
+  // A group that isn't opened yet holds the groups after it.
+  stream.open(1, 1);
+  BOOST_TEST(stream.insert(stream.part(1, 0), theorem(2)));
+  stream.finish(stream.part(1, 0));
+  BOOST_TEST(passed.size() == 3);
+  BOOST_TEST(stream.done());
+}
+
+BOOST_AUTO_TEST_CASE(later_groups_wait_for_unopened_ones) {
+  TheoremStream stream(sink, rule_stats, 2);
+  stream.open(1, 1);
+  BOOST_TEST(stream.insert(stream.part(1, 0), theorem(0)));
+  stream.finish(stream.part(1, 0));
+  BOOST_TEST(passed.empty());
+  stream.open(0, 0);
+  BOOST_TEST(passed.size() == 1);
+  BOOST_TEST(stream.done());
+}
+
+BOOST_AUTO_TEST_CASE(first_part_flushes_early) {
+  TheoremStream stream(sink, rule_stats, 1, 2);
+  stream.open(0, 2);
+  BOOST_TEST(stream.insert(stream.part(0, 1), theorem(2)));
+  BOOST_TEST(stream.insert(stream.part(0, 1), theorem(3)));
+  // Only the first part that isn't passed yet flushes.
+  BOOST_TEST(passed.empty());
+  BOOST_TEST(stream.insert(stream.part(0, 0), theorem(0)));
+  BOOST_TEST(passed.empty());
+  BOOST_TEST(stream.insert(stream.part(0, 0), theorem(1)));
+  BOOST_TEST(passed.size() == 2);
+  BOOST_TEST(stream.part(0, 0).theorems.empty());
+  stream.finish(stream.part(0, 0));
+  BOOST_TEST(passed.size() == 4);
+  stream.finish(stream.part(0, 1));
+  BOOST_TEST(stream.done());
+}
+
+BOOST_AUTO_TEST_CASE(duplicates_are_dropped) {
+  TheoremStream stream(sink, rule_stats, 1);
+  stream.open(0, 2);
+  BOOST_TEST(stream.insert(stream.part(0, 0), theorem(0)));
+  BOOST_TEST(!stream.insert(stream.part(0, 0), theorem(0)));
+  BOOST_TEST(stream.insert(stream.part(0, 1), theorem(0)));
+  BOOST_TEST(stream.insert(stream.part(0, 1), theorem(1)));
+  stream.finish(stream.part(0, 1));
+  stream.finish(stream.part(0, 0));
+  BOOST_TEST(passed.size() == 2);
+  BOOST_TEST((passed[0] == key(0)));
+  BOOST_TEST((passed[1] == key(1)));
+  BOOST_TEST(rule_stats[key(0).name()].matched == 2);
+  BOOST_TEST(rule_stats[key(0).name()].duplicates == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
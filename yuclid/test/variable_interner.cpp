@@ -0,0 +1,52 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE variable_interner_tests
+#include "ar/variable_interner.hpp"
+#include "problem.hpp"
+#include "type/point.hpp"
+#include "type/sin_or_dist.hpp"
+#include "type/squared_dist.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+#include <cstddef>
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(variable_interner_tests)
+
+BOOST_AUTO_TEST_CASE(dense_ids_in_insertion_order) {
+  Problem prob;
+  std::ignore = prob.add_point("a", 0.0, 0.0);
+  std::ignore = prob.add_point("b", 1.0, 0.0);
+  std::ignore = prob.add_point("c", 0.0, 1.0);
+  Point const a = prob.find_point("a");
+  Point const b = prob.find_point("b");
+  Point const c = prob.find_point("c");
+
+  VariableInterner<SinOrDist> interner;
+  SinOrDist const ab(SquaredDist(a, b));
+  SinOrDist const bc(SquaredDist(b, c));
+  BOOST_TEST(interner.find(ab) == VariableInterner<SinOrDist>::no_id);
+  BOOST_TEST(interner.intern(bc) == 0);
+  BOOST_TEST(interner.intern(ab) == 1);
+  BOOST_TEST(interner.intern(bc) == 0);
+  BOOST_TEST(interner.find(ab) == 1);
+  BOOST_TEST(interner.size() == 2);
+  BOOST_TEST((interner.var(0) == bc));
+  BOOST_TEST((interner.var(1) == ab));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
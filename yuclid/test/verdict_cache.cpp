@@ -0,0 +1,56 @@
+/**
+   Copyright 2025 Concordance Inc. dba Harmonic
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#define BOOST_TEST_MODULE verdict_cache_tests
+#include "problem.hpp"
+#include "statement/coll.hpp"
+#include "statement/cong.hpp"
+#include "type/dist.hpp"
+#include "type/point.hpp"
+#include "verdict_cache.hpp"
+#include <boost/test/unit_test.hpp> // NOLINT
+
+using namespace std;
+using namespace Yuclid;
+
+BOOST_AUTO_TEST_SUITE(verdict_cache_tests)
+
+BOOST_AUTO_TEST_CASE(same_verdicts_as_statements) {
+  Problem prob;
+  std::ignore = prob.add_point("a", 0.0, 0.0);
+  std::ignore = prob.add_point("b", 1.0, 0.0);
+  std::ignore = prob.add_point("c", 2.0, 0.0);
+  std::ignore = prob.add_point("d", 0.0, 1.0);
+  Point const a = prob.find_point("a");
+  Point const b = prob.find_point("b");
+  Point const c = prob.find_point("c");
+  Point const d = prob.find_point("d");
+
+  VerdictCache cache;
+  BOOST_TEST(cache.check_numerically(Collinear(a, b, c)));
+  BOOST_TEST(!cache.check_numerically(Collinear(a, b, d)));
+  BOOST_TEST(cache.check_numerically(DistEqDist(Dist(a, b), Dist(b, c))));
+  BOOST_TEST(cache.hits() == 0);
+  BOOST_TEST(cache.misses() == 3);
+
+  BOOST_TEST(cache.check_numerically(Collinear(a, b, c)));
+  BOOST_TEST(!cache.check_numerically(Collinear(a, b, d)));
+  BOOST_TEST(cache.check_numerically(DistEqDist(Dist(a, b), Dist(b, c))));
+  BOOST_TEST(!cache.check_numerically(DistEqDist(Dist(a, b), Dist(a, c))));
+  BOOST_TEST(cache.hits() == 3);
+  BOOST_TEST(cache.misses() == 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@ from newclid.agent.follow_deductions import FollowDeductions
 from newclid.api import GeometricSolverBuilder
 from newclid.jgex.problem_builder import JGEXProblemBuilder
 from py_yuclid.api_default import HEDefault
+from py_yuclid import yuclid_adapter
 from py_yuclid.yuclid_adapter import YuclidAdapter
 
 
@@ -70,3 +71,18 @@ class TestYuclid:
         )
         success = solver.run()
         assert success
+
+    @pytest.mark.skipif(
+        yuclid_adapter._yuclid is None or not yuclid_adapter.YUCLID_PATH.is_file(),
+        reason="needs both the extension module and the binary",
+    )
+    def test_in_process_matches_binary(self):
+        problem = self.problem_builder.with_problem_from_txt(
+            "a b c = triangle a b c; d = midpoint d a b; e = midpoint e a c"
+            " ? para d e b c"
+        ).build()
+        in_process = YuclidAdapter("in_process")
+        in_process._precomputation_input = yuclid_adapter._write_yuclid_setup(problem)
+        by_binary = YuclidAdapter("by_binary")
+        by_binary._precomputation_input = in_process._precomputation_input
+        assert in_process._run_yuclid_in_process(problem) == by_binary._run_yuclid()